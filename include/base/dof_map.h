@@ -39,6 +39,7 @@
 #include "libmesh/enum_elem_type.h"
 #include "libmesh/mesh_subdivision_support.h"
 #include "libmesh/dof_map_base.h"
+#include "libmesh/ghost_exchange_plan.h"
 
 // TIMPI includes
 #include "timpi/parallel_implementation.h"
@@ -50,6 +51,7 @@
 #include <iterator>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <memory>
 
@@ -112,6 +114,83 @@ class DofConstraints : public std::map<dof_id_type,
 {
 };
 
+/**
+ * A read-only copy of a DofConstraints matrix in compressed sparse
+ * row form.  Rows are sorted by constrained dof id, so the rows
+ * constraining any contiguous range of dofs (such as those local to a
+ * processor) are contiguous too, and finding a row is a binary search
+ * of one array rather than a walk through a tree.
+ */
+class DofConstraintsCSR
+{
+public:
+  /**
+   * Replaces our contents with a copy of \p constraints.
+   */
+  void build (const DofConstraints & constraints);
+
+  /**
+   * Discards our contents.
+   */
+  void clear ();
+
+  /**
+   * \returns \p true if we have been built since we were last
+   * cleared.
+   */
+  bool built () const { return _built; }
+
+  std::size_t n_rows () const { return _row_dofs.size(); }
+
+  /**
+   * \returns The index of the first row constraining a dof no less
+   * than \p dof.
+   */
+  std::size_t lower_bound (dof_id_type dof) const
+  { return std::lower_bound(_row_dofs.begin(), _row_dofs.end(), dof) - _row_dofs.begin(); }
+
+  /**
+   * \returns The index of the row constraining \p dof, or \p
+   * n_rows() if \p dof is unconstrained.
+   */
+  std::size_t find_row (dof_id_type dof) const
+  {
+    const std::size_t r = this->lower_bound(dof);
+    return (r != _row_dofs.size() && _row_dofs[r] == dof) ? r : _row_dofs.size();
+  }
+
+  /**
+   * \returns The dof constrained by row \p r.
+   */
+  dof_id_type row_dof (std::size_t r) const { return _row_dofs[r]; }
+
+  /**
+   * The entries of row \p r are those with indices from \p
+   * row_begin(r) up to but not including \p row_end(r).
+   */
+  std::size_t row_begin (std::size_t r) const { return _offsets[r]; }
+
+  std::size_t row_end (std::size_t r) const { return _offsets[r+1]; }
+
+  /**
+   * \returns The constraining dofs and coefficients of all entries.
+   */
+  const std::vector<dof_id_type> & cols () const { return _cols; }
+
+  const std::vector<Real> & vals () const { return _vals; }
+
+private:
+  bool _built = false;
+
+  std::vector<dof_id_type> _row_dofs;
+
+  std::vector<std::size_t> _offsets;
+
+  std::vector<dof_id_type> _cols;
+
+  std::vector<Real> _vals;
+};
+
 /**
  * Storage for DofConstraint right hand sides for a particular
  * problem.  Each dof id with a non-zero constraint offset
@@ -286,6 +365,92 @@ public:
    */
   void clear_sparsity();
 
+  /**
+   * Sets whether compute_sparsity() should reuse the elements which
+   * coupling functors coupled to each local element in the previous
+   * computation.  After local refinement or coarsening, only elements
+   * in or coupled to a refined or coarsened patch then need to query
+   * the coupling functors again.
+   *
+   * This assumes coupling functor output depends only on the mesh.
+   * Saved coupling keeps its own copies of coupling matrices, and is
+   * discarded when coupling functors are added or removed or when
+   * reinit() changes the default coupling; users who change coupling
+   * functor behavior otherwise should disable and re-enable reuse to
+   * discard it.
+   *
+   * Disabled by default, and unavailable without unique ids.
+   */
+  void set_incremental_sparsity(bool incremental);
+
+  bool incremental_sparsity() const
+  { return _sparsity_coupling_graph.get(); }
+
+  /**
+   * Sets whether compute_sparsity() should, when every variable is
+   * in one group of block_size() > 1 variables, build the sparsity
+   * pattern between blocks of block_size() consecutive dofs rather
+   * than between individual dofs.  This needs roughly block_size()^2
+   * less memory and work, and gives exact preallocation for
+   * block-sparse (e.g. PETSc BAIJ) matrix storage; for scalar matrix
+   * storage it can overestimate nonzeros when a sparse
+   * CouplingMatrix is used.
+   *
+   * Block sparsity is only used if no attached matrix needs the full
+   * sparsity pattern and no extra sparsity function or object is
+   * attached; sparsity_block_size() returns the block size
+   * compute_sparsity() will actually use.
+   *
+   * Enabled by default iff libMesh is configured with blocked
+   * storage.
+   */
+  void set_blocked_sparsity(bool blocked)
+  { _blocked_sparsity = blocked; }
+
+  bool blocked_sparsity() const
+  { return _blocked_sparsity; }
+
+  /**
+   * \returns The size of the dof blocks compute_sparsity() will
+   * build the sparsity pattern between, or 1 for scalar sparsity.
+   */
+  unsigned int sparsity_block_size() const;
+
+  /**
+   * Sets whether compute_sparsity(), when no attached matrix needs
+   * the full sparsity pattern and no extra sparsity function or
+   * object is attached, should compute the number of nonzeros in
+   * each row without ever storing the sparsity pattern graph.  This
+   * keeps only element dof lists in memory, which greatly reduces
+   * the peak memory of sparsity computation, at the cost of some
+   * extra sorting.  Counts are still exact.
+   *
+   * Disabled by default.
+   */
+  void set_count_only_sparsity(bool count_only)
+  { _count_only_sparsity = count_only; }
+
+  bool count_only_sparsity() const
+  { return _count_only_sparsity; }
+
+  /**
+   * Sets whether to cache the global dof indices of every active
+   * local element, in total and for each variable.  dof_indices()
+   * calls for those elements at their own p level, such as those
+   * made by FEMContext::pre_fe_reinit() throughout every assembly,
+   * then copy from the cache rather than traversing the element and
+   * node DofObjects.
+   *
+   * The cache is rebuilt by each distribute_dofs(), and is built
+   * immediately if dofs have already been distributed.
+   *
+   * Disabled by default.
+   */
+  void set_cache_elem_dof_indices(bool cache);
+
+  bool cache_elem_dof_indices() const
+  { return _elem_dof_cache.get(); }
+
   /**
    * Remove any default ghosting functor(s).  User-added ghosting
    * functors will be unaffected.
@@ -507,6 +672,7 @@ public:
   void clear_send_list ()
   {
     _send_list.clear();
+    _send_list_plan.reset();
   }
 
   /**
@@ -532,6 +698,15 @@ public:
    */
   const std::vector<dof_id_type> & get_send_list() const { return _send_list; }
 
+  /**
+   * \returns The communication pattern for localizing the values on
+   * the \p _send_list, built by \p prepare_send_list(), or \p
+   * nullptr if the send list has been modified since then or there is
+   * only one processor.
+   */
+  const GhostExchangePlan * get_send_list_plan() const
+  { return _send_list_plan.get(); }
+
   /**
    * \returns A constant reference to the \p _n_nz list for this processor.
    *
@@ -819,6 +994,12 @@ public:
     return cast_int<processor_id_type>(ub - _end_df.begin());
   }
 
+  /**
+   * Fills the vector \p di with the global degree of freedom indices
+   * for the element, for all variables.  If element dof index
+   * caching is enabled and \p elem is an active local element, this
+   * copies them from the cache.
+   */
   void dof_indices (const Elem * const elem,
                     std::vector<dof_id_type> & di) const;
 
@@ -985,6 +1166,42 @@ public:
    */
   void set_implicit_neighbor_dofs(bool implicit_neighbor_dofs);
 
+  /**
+   * Orderings which distribute_dofs() can apply to the degrees of
+   * freedom on each processor, in place of the default order in which
+   * local elements are iterated over:
+   *
+   * ELEMENT_ORDER numbers dofs as local elements are encountered.
+   *
+   * REVERSE_CUTHILL_MCKEE numbers the dofs on local nodes and elements
+   * in reverse Cuthill-McKee order of their element connectivity
+   * graph, reducing the bandwidth of the local matrix block.
+   *
+   * SPACE_FILLING_CURVE numbers the dofs on local nodes and elements
+   * in Morton (Z curve) order of their locations, improving the
+   * locality of mesh neighbors' dofs.
+   *
+   * In every case the var-major or node-major (with \p
+   * --node-major-dofs) grouping of dofs is preserved, and processor
+   * ownership of dofs is unchanged.
+   */
+  enum class LocalDofOrdering {ELEMENT_ORDER,
+                               REVERSE_CUTHILL_MCKEE,
+                               SPACE_FILLING_CURVE};
+
+  /**
+   * Allow the local dof ordering to be set programmatically.  This
+   * overrides the --dof-ordering commandline option, which accepts
+   * "element", "rcm", or "sfc".  The new ordering takes effect the
+   * next time dofs are distributed.
+   */
+  void set_local_dof_ordering(LocalDofOrdering ordering);
+
+  /**
+   * \returns The ordering to be used for local dofs.
+   */
+  LocalDofOrdering local_dof_ordering() const;
+
   /**
    * Set the _verify_dirichlet_bc_consistency flag.
    */
@@ -1176,16 +1393,25 @@ public:
    */
   const DofConstraints & get_dof_constraints() const { return _dof_constraints; }
 
+  /**
+   * \returns The compressed sparse row copy of the DofConstraints
+   * which \p process_constraints() builds, for fast application of
+   * constraints.  Any later change to the constraints clears it.
+   */
+  const DofConstraintsCSR & get_dof_constraints_csr() const { return _dof_constraints_csr; }
+
   void stash_dof_constraints()
   {
     libmesh_assert(_stashed_dof_constraints.empty());
     _dof_constraints.swap(_stashed_dof_constraints);
+    _dof_constraints_csr.clear();
   }
 
   void unstash_dof_constraints()
   {
     libmesh_assert(_dof_constraints.empty());
     _dof_constraints.swap(_stashed_dof_constraints);
+    _dof_constraints_csr.clear();
   }
 
   /**
@@ -1203,6 +1429,7 @@ public:
   void swap_dof_constraints()
   {
     _dof_constraints.swap(_stashed_dof_constraints);
+    _dof_constraints_csr.clear();
   }
 
 #ifdef LIBMESH_ENABLE_NODE_CONSTRAINTS
@@ -1758,10 +1985,36 @@ public:
    * Can be told to calculate sparsity for the constrained matrix,
    * which may be necessary in the case of spline control node
    * constraints or sufficiently many user constraints.
+   *
+   * If \p coupling_graph is provided, coupling functor results
+   * recorded there by a previous build are reused wherever still
+   * valid, and are replaced by the results of this build.
+   *
+   * If \p block_size is greater than 1, the pattern is built
+   * between blocks of that many consecutive dofs; see
+   * sparsity_block_size().
+   *
+   * If \p count_only is true, only the number of nonzeros in each
+   * row is computed; see set_count_only_sparsity().
    */
   std::unique_ptr<SparsityPattern::Build> build_sparsity(const MeshBase & mesh,
                                                          bool calculate_constrained = false,
-                                                         bool use_condensed_system = false) const;
+                                                         bool use_condensed_system = false,
+                                                         SparsityPattern::CouplingGraph * coupling_graph = nullptr,
+                                                         unsigned int block_size = 1,
+                                                         bool count_only = false) const;
+
+  /**
+   * Partitions the active local elements of \p mesh into colors, such
+   * that no two elements of the same color share any degree of
+   * freedom, including those their dofs are constrained in terms of.
+   * The contributions of elements of one color to a global matrix or
+   * vector may then be added concurrently without conflicts.
+   *
+   * Colors are assigned greedily, in local element order.
+   */
+  std::vector<std::vector<const Elem *>>
+  color_active_local_elements (const MeshBase & mesh) const;
 
   /**
    * Describe whether the given variable group should be p-refined. If this API is not called with
@@ -1978,6 +2231,16 @@ private:
    */
   void distribute_scalar_dofs (dof_id_type & next_free_dof);
 
+  /**
+   * Permutes the dof indices on the DofObjects owned by this
+   * processor, within this processor's dof range, into \p ordering.
+   * Dofs are renumbered in var-major or node-major groups, depending
+   * on \p node_major_dofs, to match the initial distribution.
+   */
+  void renumber_local_dofs (MeshBase & mesh,
+                            bool node_major_dofs,
+                            LocalDofOrdering ordering);
+
 #ifdef DEBUG
   /*
    * Internal assertions for distribute_local_dofs_*
@@ -2007,6 +2270,17 @@ private:
 
 #ifdef LIBMESH_ENABLE_CONSTRAINTS
 
+  /**
+   * Calls \p f(constraining_dof, coefficient) for each entry in the
+   * constraint row of \p dof, from \p _dof_constraints_csr if it is
+   * built or from \p _dof_constraints otherwise.
+   *
+   * \returns \p false if \p dof is unconstrained.
+   */
+  template <typename Func>
+  bool for_each_constraint_entry (const dof_id_type dof,
+                                  Func f) const;
+
   /**
    * Build the constraint matrix C associated with the element
    * degree of freedom indices elem_dofs. The optional parameter
@@ -2151,6 +2425,11 @@ private:
    */
   std::vector<dof_id_type> _send_list;
 
+  /**
+   * The ghost exchange pattern for the \p _send_list.
+   */
+  std::unique_ptr<GhostExchangePlan> _send_list_plan;
+
   /**
    * Function object to call to add extra entries to the sparsity pattern
    */
@@ -2244,6 +2523,63 @@ private:
    */
   std::unique_ptr<SparsityPattern::Build> _sp;
 
+  /**
+   * The element coupling found when computing \p _sp, if we are
+   * reusing it for incremental sparsity computations.
+   */
+  std::unique_ptr<SparsityPattern::CouplingGraph> _sparsity_coupling_graph;
+
+  /**
+   * Whether to build sparsity patterns between blocks of dofs when
+   * possible.
+   */
+#ifdef LIBMESH_ENABLE_BLOCKED_STORAGE
+  bool _blocked_sparsity = true;
+#else
+  bool _blocked_sparsity = false;
+#endif
+
+  /**
+   * Whether to compute only sparsity pattern row counts when
+   * possible.
+   */
+  bool _count_only_sparsity = false;
+
+  /**
+   * Global dof indices of active local elements, if we are caching
+   * them: the indices for variable \p v on the element with cache
+   * entry \p e are
+   * dofs[offsets[e*n_variables()+v]] through
+   * dofs[offsets[e*n_variables()+v+1]-1].
+   */
+  struct ElemDofIndexCache
+  {
+    std::unordered_map<dof_id_type, std::size_t> index;
+    std::vector<const Elem *> elems;
+    std::vector<std::size_t> offsets;
+    std::vector<dof_id_type> dofs;
+  };
+
+  std::unique_ptr<ElemDofIndexCache> _elem_dof_cache;
+
+  /**
+   * Fills the element dof index cache for the active local elements
+   * of \p mesh.
+   */
+  void build_elem_dof_cache (const MeshBase & mesh);
+
+  /**
+   * Copies the cached dof indices of variables \p v_begin through
+   * \p v_end-1 on \p elem into \p di.
+   *
+   * \returns \p false, leaving \p di untouched, if \p elem isn't
+   * cached.
+   */
+  bool cached_dof_indices (const Elem & elem,
+                           std::vector<dof_id_type> & di,
+                           unsigned int v_begin,
+                           unsigned int v_end) const;
+
   /**
    * The total number of SCALAR dofs associated to
    * all SCALAR variables.
@@ -2271,6 +2607,12 @@ private:
    */
   DofConstraints _dof_constraints, _stashed_dof_constraints;
 
+  /**
+   * Compressed copy of \p _dof_constraints, valid from the end of
+   * \p process_constraints() until the constraints are next modified.
+   */
+  DofConstraintsCSR _dof_constraints_csr;
+
   DofConstraintValueMap      _primal_constraint_values;
 
   AdjointDofConstraintValues _adjoint_constraint_values;
@@ -2315,6 +2657,20 @@ private:
   bool _implicit_neighbor_dofs_initialized;
   bool _implicit_neighbor_dofs;
 
+  /**
+   * The local dof ordering, if set programmatically, to override the
+   * --dof-ordering commandline option.
+   */
+  bool _local_dof_ordering_initialized;
+  LocalDofOrdering _local_dof_ordering;
+
+  /**
+   * True if local dofs were renumbered after their initial
+   * distribution, in which case they are not numbered in local
+   * element order.
+   */
+  bool _local_dofs_renumbered;
+
   /**
    * Flag which determines whether we should do some additional
    * checking of the consistency of the DirichletBoundary objects
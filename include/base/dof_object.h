@@ -21,6 +21,7 @@
 #define LIBMESH_DOF_OBJECT_H
 
 // Local includes
+#include "libmesh/dof_index_buffer.h"
 #include "libmesh/id_types.h"
 #include "libmesh/int_range.h"
 #include "libmesh/libmesh_config.h"
@@ -510,6 +511,34 @@ public:
    */
   void pack_indexing(std::back_insert_iterator<std::vector<largest_id_type>> target) const;
 
+  /**
+   * \returns The number of entries in our indexing buffer, which is
+   * how much room \p move_indexing_to() will need.
+   */
+  unsigned int indexing_size() const;
+
+  /**
+   * Copies our DoF indexing (and extra integer) data into \p
+   * storage, which must have room for \p indexing_size() entries,
+   * frees our own copy, and uses \p storage from then on.  This lets
+   * a mesh pack the indexing of all its objects into one buffer.
+   *
+   * The indexing is moved back into storage owned by this object the
+   * next time its size changes, e.g. on \p add_system(), so \p
+   * storage only needs to outlive this object until then.
+   *
+   * \returns One past the end of the data copied into \p storage.
+   */
+  dof_id_type * move_indexing_to (dof_id_type * storage);
+
+  /**
+   * \returns \p true if our indexing data is currently stored in the
+   * range [begin, end), e.g. within a buffer passed to a previous \p
+   * move_indexing_to() call.
+   */
+  bool indexing_stored_in (const dof_id_type * begin,
+                           const dof_id_type * end) const;
+
   /**
    * Print our buffer for debugging.
    */
@@ -667,7 +696,7 @@ private:
    * \endverbatim
    */
   typedef dof_id_type index_t;
-  typedef std::vector<index_t> index_buffer_t;
+  typedef DofIndexBuffer index_buffer_t;
   index_buffer_t _idx_buf;
 
   /**
@@ -706,7 +735,7 @@ private:
 #ifdef LIBMESH_IS_UNIT_TESTING
 public:
   void set_buffer (const std::vector<dof_id_type> & buf)
-  { _idx_buf = buf; }
+  { _idx_buf.assign(buf.begin(), buf.end()); }
 #endif
 };
 
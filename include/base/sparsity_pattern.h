@@ -26,7 +26,10 @@
 
 // C++ includes
 #include <algorithm> // is_sorted
+#include <memory>
+#include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 namespace libMesh
@@ -35,6 +38,7 @@ namespace libMesh
 // Forward declarations
 class DofMap;
 class CouplingMatrix;
+class MeshBase;
 class StaticCondensationDofMap;
 
 /**
@@ -54,6 +58,33 @@ class Graph : public std::vector<Row> {};
 
 class NonlocalGraph : public std::map<dof_id_type, Row> {};
 
+/**
+ * An element which a coupling functor coupled to, with the coupling
+ * matrix it used.  The element is looked up by \p id; its \p
+ * unique_id tells whether that id still refers to the same element.
+ *
+ * The coupling matrix is a copy, shared by every entry which used the
+ * same matrix in one build, so a graph kept between builds never
+ * refers to a matrix which its coupling functor has since changed or
+ * freed.
+ */
+struct CoupledElem
+{
+  dof_id_type id;
+  unique_id_type unique_id;
+  std::shared_ptr<const CouplingMatrix> coupling;
+};
+
+/**
+ * The elements and coupling matrices which coupling functors coupled
+ * to each active local element (by unique_id) in a previous sparsity
+ * pattern build.  These remain valid for as long as every coupled
+ * element remains active, which after mesh refinement is true
+ * everywhere outside of refined and coarsened patches and their
+ * coupling neighborhoods.
+ */
+class CouplingGraph : public std::unordered_map<unique_id_type, std::vector<CoupledElem>> {};
+
 /**
  * Splices the two sorted ranges [begin,middle) and [middle,end)
  * into one sorted range [begin,end).  This method is much like
@@ -109,7 +140,11 @@ public:
          const bool implicit_neighbor_dofs_in,
          const bool need_full_sparsity_pattern_in,
          const bool calculate_constrained_in = false,
-         const StaticCondensationDofMap * sc = nullptr);
+         const StaticCondensationDofMap * sc = nullptr,
+         const CouplingGraph * cached_coupling_in = nullptr,
+         const MeshBase * mesh_in = nullptr,
+         const unsigned int block_size_in = 1,
+         const bool count_only_in = false);
 
   /**
    * Special functions.
@@ -148,14 +183,41 @@ public:
   /**
    * Rows of sparse matrix indices, indexed by the offset from the
    * first DoF on this processor.
+   *
+   * If get_block_size() is greater than 1, rows and indices are
+   * instead of blocks of that many consecutive DoFs, with block \p b
+   * holding DoFs \p b*get_block_size() through
+   * \p (b+1)*get_block_size()-1.
    */
   const SparsityPattern::Graph & get_sparsity_pattern() const
   { return sparsity_pattern; }
 
   /**
-   * Rows of sparse matrix indices, mapped from global DoF number,
-   * which belong on other processors.  Stored here only temporarily
-   * until a parallel_sync() sends them where they belong.
+   * The number of consecutive DoFs in each row and index of the
+   * sparsity pattern graph.  Entry counts are always given per DoF.
+   */
+  unsigned int get_block_size() const
+  { return block_size; }
+
+  /**
+   * \returns \p true if this build only computes the number of
+   * entries in each row, never storing a sparsity pattern graph.
+   */
+  bool is_count_only() const
+  { return count_only; }
+
+  /**
+   * \returns The most memory, in bytes, used by a count-only build
+   * to store element coupling and to count row entries from it, for
+   * comparison with the size of the graph it avoids building.
+   */
+  std::size_t count_only_peak_bytes() const
+  { return count_only_bytes; }
+
+  /**
+   * Rows of sparse matrix indices, mapped from global DoF (or block)
+   * number, which belong on other processors.  Stored here only
+   * temporarily until a parallel_sync() sends them where they belong.
    */
   const SparsityPattern::NonlocalGraph & get_nonlocal_pattern() const
   { return nonlocal_pattern; }
@@ -193,7 +255,25 @@ public:
                                                    std::vector<dof_id_type> & n_oz,
                                                    void * context),
                                       void * context)
-  { func(sparsity_pattern, n_nz, n_oz, context); }
+  {
+    libmesh_assert_equal_to(block_size, 1);
+    libmesh_assert(!count_only);
+    func(sparsity_pattern, n_nz, n_oz, context);
+  }
+
+  /**
+   * Swap the element coupling found by this build, if it was
+   * constructed with a \p CouplingGraph to reuse, with \p other.
+   */
+  void swap_coupling_graph(CouplingGraph & other)
+  { coupling_graph.swap(other); }
+
+  /**
+   * \returns The number of local elements whose coupling functor
+   * results were reused from a previous build.
+   */
+  std::size_t n_reused_couplings() const
+  { return n_reused; }
 
   /**
    * Clear the "full" details of our sparsity structure, leaving only
@@ -213,6 +293,34 @@ private:
   const bool need_full_sparsity_pattern;
   const bool calculate_constrained;
   const StaticCondensationDofMap * const sc;
+  const unsigned int block_size;
+  const bool count_only;
+
+  /**
+   * Element coupling from a previous build, to reuse where still
+   * valid, and the mesh in which to look up its elements.  If \p
+   * cached_coupling is provided, the coupling found by this build is
+   * recorded in \p coupling_graph.
+   */
+  const CouplingGraph * const cached_coupling;
+  const MeshBase * const mesh;
+
+  CouplingGraph coupling_graph;
+
+  /**
+   * The copy recorded in \p coupling_graph of each coupling functor
+   * matrix seen so far, so each is only copied once per build.
+   */
+  std::unordered_map<const CouplingMatrix *,
+                     std::shared_ptr<const CouplingMatrix>> coupling_copies;
+
+  /**
+   * \returns A copy of \p coupling to record in \p coupling_graph,
+   * shared with every other use of \p coupling in this build.
+   */
+  std::shared_ptr<const CouplingMatrix> recorded_coupling(const CouplingMatrix * coupling);
+
+  std::size_t n_reused;
 
   /**
    * If there are "spider" nodes in the mesh (i.e. a single node which
@@ -237,6 +345,132 @@ private:
                              std::vector<dof_id_type> & dofs_vi,
                              unsigned int vi);
 
+  /**
+   * Fills \p blocks with the sorted blocks holding any dof, of any
+   * variable, connected to \p elem.
+   */
+  void sorted_connected_blocks(const Elem * elem,
+                               std::vector<dof_id_type> & blocks);
+
+  /**
+   * A set of variables whose rows all couple to the same set of
+   * column variables.  Each element's rows for the whole block can be
+   * built at once, from the merged dofs of each set, rather than one
+   * variable pair at a time.
+   */
+  struct VariableBlock
+  {
+    std::vector<unsigned int> rows, cols;
+  };
+
+  /**
+   * The variable blocks of each coupling matrix (or of full
+   * coupling, for \p nullptr) used so far, compiled on first use.
+   */
+  std::unordered_map<const CouplingMatrix *, std::vector<VariableBlock>> compiled_couplings;
+
+  /**
+   * Fills \p blocks with the variable blocks of \p coupling.
+   */
+  void compile_coupling(const CouplingMatrix * coupling,
+                        std::vector<VariableBlock> & blocks) const;
+
+  /**
+   * \returns The variable blocks of \p coupling, compiling them if
+   * this is the first time we've seen it.
+   */
+  const std::vector<VariableBlock> & compiled_blocks(const CouplingMatrix * coupling);
+
+  /**
+   * Fills \p merged with the sorted union of the sorted \p var_dofs
+   * of each variable in \p vars.
+   */
+  static void merge_sorted_dofs(const std::vector<std::vector<dof_id_type>> & var_dofs,
+                                const std::vector<unsigned int> & vars,
+                                std::vector<dof_id_type> & merged);
+
+  /**
+   * In count-only mode, each element's sorted dof list for each
+   * variable (or its block list, with block sparsity) is stored only
+   * once, in \p list_dofs, and the coupling found so far is a set of
+   * pairs of those lists: every row in the first has an entry in
+   * every column in the second.  This takes memory proportional to
+   * the element dof lists rather than to the matrix graph.
+   */
+  struct Contribution
+  {
+    std::size_t rows, cols;
+  };
+
+  std::vector<Contribution> contributions;
+
+  /**
+   * Dof list \p l is \p list_dofs[list_offsets[l]] up to, but not
+   * including, \p list_dofs[list_offsets[l+1]].
+   */
+  std::vector<dof_id_type> list_dofs;
+  std::vector<std::size_t> list_offsets;
+
+  static constexpr std::size_t invalid_list = static_cast<std::size_t>(-1);
+
+  /**
+   * The first of each element's slots in \p element_var_lists, by
+   * element id.  Each slot holds the index of the element's dof list
+   * for one variable (or block), or \p invalid_list if that has not
+   * been needed yet.
+   */
+  std::unordered_map<dof_id_type, std::size_t> element_lists;
+  std::vector<std::size_t> element_var_lists;
+
+  /**
+   * The most memory, in bytes, held by count-only storage so far.
+   */
+  std::size_t count_only_bytes;
+
+  /**
+   * \returns The number of dof list slots each element has: one per
+   * variable, or a single one for its blocks.
+   */
+  unsigned int n_list_slots() const;
+
+  /**
+   * \returns The index of the dof list of variable \p vi (or of the
+   * blocks) on \p elem, computing and storing it on first use.
+   */
+  std::size_t dof_list(const Elem * elem, unsigned int vi);
+
+  /**
+   * Appends a dof list, returning its index.
+   */
+  std::size_t append_list(std::vector<dof_id_type>::const_iterator begin,
+                          std::vector<dof_id_type>::const_iterator end);
+
+  std::vector<dof_id_type>::const_iterator list_begin(std::size_t l) const
+  { return list_dofs.begin() + list_offsets[l]; }
+
+  std::vector<dof_id_type>::const_iterator list_end(std::size_t l) const
+  { return list_dofs.begin() + list_offsets[l+1]; }
+
+  /**
+   * \returns The memory, in bytes, currently held by count-only
+   * storage.  Hash map nodes are estimated.
+   */
+  std::size_t count_only_storage_bytes() const;
+
+  /**
+   * The count-only counterpart of parallel_sync(): sends
+   * contributions to rows owned by other processors to them, then
+   * counts the entries in each local row.
+   */
+  void parallel_sync_counts ();
+
+  /**
+   * Sets the entry counts of every DoF in a row of the graph.
+   */
+  void set_row_counts (dof_id_type row,
+                       dof_id_type row_nz,
+                       dof_id_type row_oz);
+
   SparsityPattern::Graph sparsity_pattern;
 
   SparsityPattern::NonlocalGraph nonlocal_pattern;
@@ -24,6 +24,7 @@
 #include "libmesh/fe_base.h"
 #include "libmesh/int_range.h"
 #include "libmesh/libmesh.h"
+#include "libmesh/reference_shape_cache.h"
 
 // C++ includes
 #include <cstddef>
@@ -814,6 +815,12 @@ protected:
   ElemType last_side;
 
   ElemType last_edge;
+
+  /**
+   * The reference shape cache entry our reference shape arrays were
+   * last filled from, if any, so that returning to it needs no copy.
+   */
+  std::shared_ptr<const typename ReferenceShapeCache<OutputShape>::Entry> _reference_shapes;
 };
 
 
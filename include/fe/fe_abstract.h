@@ -56,6 +56,7 @@ class Elem;
 class MeshBase;
 template <typename T> class NumericVector;
 class QBase;
+class TensorProductEvaluator;
 enum ElemType : int;
 
 #ifdef LIBMESH_ENABLE_NODE_CONSTRAINTS
@@ -635,6 +636,25 @@ public:
    */
   bool add_p_level_in_reinit() const { return _add_p_level_in_reinit; }
 
+  /**
+   * Indicate whether to compute \p phi and the reference shape
+   * derivatives by sum factorization, from 1D tables, when the basis
+   * and quadrature rule are tensor products (see \p
+   * TensorProductEvaluator).  Elements, rules and requests (second
+   * derivatives, dual bases) which don't allow it fall back to
+   * evaluating every shape function.
+   */
+  void enable_tensor_product_evaluation(bool enable = true)
+  { _enable_tensor_product = enable; }
+
+  /**
+   * \returns The evaluator which computed the current shape
+   * functions, already set up for the current element, or \p nullptr
+   * if they were not computed by sum factorization.
+   */
+  TensorProductEvaluator * get_tensor_product_evaluator() const
+  { return _tensor_product_shapes ? _tensor_product_evaluator.get() : nullptr; }
+
 protected:
 
   /**
@@ -785,6 +805,30 @@ protected:
    * Whether to add p-refinement levels in init/reinit methods
    */
   bool _add_p_level_in_reinit;
+
+  /**
+   * Whether to use sum factorization where we can
+   */
+  bool _enable_tensor_product;
+
+  /**
+   * Whether the current shape functions came from \p
+   * _tensor_product_evaluator
+   */
+  bool _tensor_product_shapes;
+
+  /**
+   * Whether \p phi was filled on the reference element by \p
+   * init_shape_functions(), with the reference shape cache, and needs
+   * no mapping
+   */
+  bool _reference_phi;
+
+  /**
+   * The evaluator for the last element type, p level and quadrature
+   * rule we could factor
+   */
+  std::unique_ptr<TensorProductEvaluator> _tensor_product_evaluator;
 };
 
 } // namespace libMesh
@@ -0,0 +1,209 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2025 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_FE_BATCH_H
+#define LIBMESH_FE_BATCH_H
+
+// Local includes
+#include "libmesh/libmesh_common.h"
+#include "libmesh/enum_elem_type.h"
+#include "libmesh/fe_type.h"
+#include "libmesh/packed_shape_array.h"
+#include "libmesh/point.h"
+#include "libmesh/vector_value.h"
+
+// C++ includes
+#include <vector>
+
+namespace libMesh
+{
+
+// Forward declarations
+class Elem;
+class QBase;
+
+/**
+ * Reinitializes the mapping and the physical shape function
+ * gradients of several elements at once.
+ *
+ * All elements in a batch share one element type and quadrature
+ * rule, so reference shape function data is shared, and the
+ * per-element work (the map Jacobian, its inverse, \p JxW and \p
+ * dphi) is done with the element ("lane") index fastest.  Each
+ * quadrature point's arithmetic then becomes a loop over \p n_lanes
+ * independent elements, which compilers vectorize even when the
+ * quadrature rule itself is too small to.
+ *
+ * Results are stored structure-of-arrays: the \p n_lanes values for
+ * one quadrature point (and shape function and component, where
+ * applicable) are contiguous and aligned, and are available via \p
+ * JxW_lanes() and \p dphi_lanes() for vectorized assembly loops, or
+ * one lane at a time via \p JxW() and \p dphi().
+ *
+ * Only Lagrange mappings of elements without p refinement are
+ * supported, along with bases whose reference shape functions do not
+ * depend on the element; see \p supports().  Results otherwise match
+ * those of \p FE::reinit().
+ *
+ * \date 2025
+ * \brief Batched multi-element FE reinitialization.
+ */
+class FEBatch
+{
+public:
+  /**
+   * The number of elements processed together; enough for one
+   * AVX-512 register (or two AVX2 registers) of double precision
+   * values per operation.
+   */
+  static constexpr unsigned int n_lanes = 8;
+
+  /**
+   * \returns \p true if \p fe_type shape functions on \p elem_type
+   * elements can be batched.
+   */
+  static bool supports (const FEType & fe_type,
+                        ElemType elem_type);
+
+  /**
+   * Constructor.  Evaluates reference shape function and mapping data
+   * for \p fe_type on \p elem_type at the points of \p qrule, which
+   * must already be initialized for \p elem_type.
+   */
+  FEBatch (const FEType & fe_type,
+           ElemType elem_type,
+           const QBase & qrule);
+
+  /**
+   * Computes mapping and shape function data on each of \p elems,
+   * which must number between 1 and \p n_lanes and all be of our
+   * element type.  Lanes past \p elems.size() repeat the last element.
+   */
+  void reinit (const std::vector<const Elem *> & elems);
+
+  /**
+   * \returns The number of elements from the last reinit().
+   */
+  unsigned int n_elems () const { return _n_elems; }
+
+  unsigned int n_dofs () const { return _n_dofs; }
+
+  unsigned int n_points () const { return _n_qp; }
+
+  /**
+   * \returns Shape function values, as from \p FEBase::get_phi();
+   * these are the same on every element.
+   */
+  const std::vector<std::vector<Real>> & get_phi () const { return _phi; }
+
+  /**
+   * \returns The \p n_lanes values of JxW at quadrature point \p qp.
+   */
+  const Real * JxW_lanes (unsigned int qp) const
+  { libmesh_assert_less(qp, _n_qp); return _JxW.data() + qp*n_lanes; }
+
+  /**
+   * \returns The \p n_lanes values of component \p d of the gradient
+   * of shape function \p i at quadrature point \p qp.
+   */
+  const Real * dphi_lanes (unsigned int i, unsigned int qp, unsigned int d) const
+  { libmesh_assert_less(d, LIBMESH_DIM); return _dphi[d].row(i) + qp*n_lanes; }
+
+  /**
+   * \returns The \p n_lanes values of component \p d of the physical
+   * location of quadrature point \p qp.
+   */
+  const Real * xyz_lanes (unsigned int qp, unsigned int d) const
+  { libmesh_assert_less(d, LIBMESH_DIM); return _xyz[d].row(0) + qp*n_lanes; }
+
+  Real JxW (unsigned int qp, unsigned int lane) const
+  { libmesh_assert_less(lane, _n_elems); return this->JxW_lanes(qp)[lane]; }
+
+  RealGradient dphi (unsigned int i, unsigned int qp, unsigned int lane) const;
+
+  Point xyz (unsigned int qp, unsigned int lane) const;
+
+private:
+
+  ElemType _elem_type;
+
+  unsigned int _dim, _n_dofs, _n_map, _n_qp;
+
+  unsigned int _n_elems = 0;
+
+  std::vector<Real> _weights;
+
+  std::vector<std::vector<Real>> _phi;
+
+  /**
+   * Reference derivatives of the shape functions, and values and
+   * reference derivatives of the mapping shape functions, indexed
+   * [d](i, qp).
+   */
+  PackedShapeArray<Real> _dphidxi[3], _psi, _dpsidxi[3];
+
+  /**
+   * Per-lane results.  Each row of \p _dphi[d] holds one shape
+   * function's gradient component at every quadrature point and
+   * lane, lane fastest; \p _xyz[d] has a single such row.
+   */
+  std::vector<Real, AlignedAllocator<Real, 64>> _JxW;
+
+  PackedShapeArray<Real> _dphi[LIBMESH_DIM], _xyz[LIBMESH_DIM];
+
+  /**
+   * Scratch space: node coordinates, indexed (d, node*n_lanes +
+   * lane), and the inverse map, indexed (xi direction, physical
+   * direction), qp*n_lanes + lane.
+   */
+  PackedShapeArray<Real> _node_xyz, _dxidx[3];
+};
+
+
+
+inline
+RealGradient FEBatch::dphi (unsigned int i,
+                            unsigned int qp,
+                            unsigned int lane) const
+{
+  libmesh_assert_less(lane, _n_elems);
+
+  RealGradient grad;
+  for (unsigned int d = 0; d != LIBMESH_DIM; ++d)
+    grad(d) = this->dphi_lanes(i, qp, d)[lane];
+  return grad;
+}
+
+
+
+inline
+Point FEBatch::xyz (unsigned int qp,
+                    unsigned int lane) const
+{
+  libmesh_assert_less(lane, _n_elems);
+
+  Point p;
+  for (unsigned int d = 0; d != LIBMESH_DIM; ++d)
+    p(d) = this->xyz_lanes(qp, d)[lane];
+  return p;
+}
+
+} // namespace libMesh
+
+#endif // LIBMESH_FE_BATCH_H
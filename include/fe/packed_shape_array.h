@@ -0,0 +1,176 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2025 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_PACKED_SHAPE_ARRAY_H
+#define LIBMESH_PACKED_SHAPE_ARRAY_H
+
+// Local includes
+#include "libmesh/libmesh_common.h"
+
+// C++ includes
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace libMesh
+{
+
+/**
+ * A minimal allocator returning memory aligned to \p Align bytes,
+ * suitable for SIMD loads of the values it holds.
+ */
+template <typename T, std::size_t Align>
+struct AlignedAllocator
+{
+  typedef T value_type;
+
+  template <typename U>
+  struct rebind { typedef AlignedAllocator<U, Align> other; };
+
+  AlignedAllocator () = default;
+
+  template <typename U>
+  AlignedAllocator (const AlignedAllocator<U, Align> &) {}
+
+  T * allocate (std::size_t n)
+  {
+    return static_cast<T *>
+      (::operator new(n * sizeof(T), std::align_val_t(Align)));
+  }
+
+  void deallocate (T * p, std::size_t)
+  {
+    ::operator delete(p, std::align_val_t(Align));
+  }
+
+  template <typename U>
+  bool operator== (const AlignedAllocator<U, Align> &) const { return true; }
+
+  template <typename U>
+  bool operator!= (const AlignedAllocator<U, Align> &) const { return false; }
+};
+
+
+
+/**
+ * Shape function data (values, gradients, etc.) for every shape
+ * function at every quadrature point, in one aligned buffer with the
+ * quadrature point index fastest.  Each row (one shape function, all
+ * quadrature points) begins on a cache line boundary whenever the
+ * value type evenly divides one, so loops over \p row(i) can be
+ * vectorized by the compiler.
+ *
+ * Resizing to a smaller (or equal) number of entries never
+ * reallocates, so switching between quadrature rules of different
+ * sizes does not churn the heap.
+ *
+ * \date 2025
+ * \brief Contiguous 2D storage for shape function data.
+ */
+template <typename T>
+class PackedShapeArray
+{
+public:
+  /**
+   * Alignment, in bytes, of the storage and of each row whenever
+   * possible.
+   */
+  static constexpr std::size_t alignment =
+    std::max(std::size_t(64), alignof(T));
+
+  PackedShapeArray () = default;
+
+  /**
+   * \returns The number of shape functions (rows).
+   */
+  unsigned int n_shapes () const { return _n_shapes; }
+
+  /**
+   * \returns The number of quadrature points (entries per row).
+   */
+  unsigned int n_points () const { return _n_points; }
+
+  /**
+   * \returns The distance between the start of consecutive rows;
+   * this is \p n_points() rounded up for alignment.
+   */
+  std::size_t stride () const { return _stride; }
+
+  /**
+   * \returns A pointer to the \p n_points() contiguous values of
+   * shape function \p i.
+   */
+  const T * row (unsigned int i) const
+  { libmesh_assert_less(i, _n_shapes); return _data.data() + i*_stride; }
+
+  T * row (unsigned int i)
+  { libmesh_assert_less(i, _n_shapes); return _data.data() + i*_stride; }
+
+  /**
+   * \returns The value of shape function \p i at quadrature point \p qp.
+   */
+  const T & operator() (unsigned int i, unsigned int qp) const
+  { libmesh_assert_less(qp, _n_points); return this->row(i)[qp]; }
+
+  T & operator() (unsigned int i, unsigned int qp)
+  { libmesh_assert_less(qp, _n_points); return this->row(i)[qp]; }
+
+  /**
+   * Resizes to \p n_shapes by \p n_points, reusing existing capacity
+   * where possible.  Entry values are unspecified afterward.
+   */
+  void resize (unsigned int n_shapes, unsigned int n_points)
+  {
+    constexpr std::size_t per_line =
+      (alignment % sizeof(T)) ? 1 : alignment / sizeof(T);
+
+    _n_shapes = n_shapes;
+    _n_points = n_points;
+    _stride = (n_points + per_line - 1) / per_line * per_line;
+
+    const std::size_t n = _stride * n_shapes;
+    if (n > _data.size())
+      _data.resize(n);
+  }
+
+  /**
+   * Empties the array, and frees its storage.
+   */
+  void clear ()
+  {
+    _n_shapes = _n_points = 0;
+    _stride = 0;
+    std::vector<T, AlignedAllocator<T, alignment>>().swap(_data);
+  }
+
+private:
+
+  unsigned int _n_shapes = 0;
+
+  unsigned int _n_points = 0;
+
+  std::size_t _stride = 0;
+
+  std::vector<T, AlignedAllocator<T, alignment>> _data;
+};
+
+} // namespace libMesh
+
+#endif // LIBMESH_PACKED_SHAPE_ARRAY_H
@@ -0,0 +1,205 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2025 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_REFERENCE_SHAPE_CACHE_H
+#define LIBMESH_REFERENCE_SHAPE_CACHE_H
+
+// Local includes
+#include "libmesh/libmesh_common.h"
+#include "libmesh/enum_elem_type.h"
+#include "libmesh/fe_type.h"
+#include "libmesh/point.h"
+
+// C++ includes
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace libMesh
+{
+
+/**
+ * A cache of shape function values and derivatives on the reference
+ * element, keyed by finite element type, element type, p level and
+ * the reference points at which they were evaluated.
+ *
+ * \p FE objects whose shape functions depend on nothing but that key
+ * (those which return \p false from \p shapes_need_reinit()) consult
+ * the cache for their thread before evaluating reference shapes, so
+ * assembly on a mesh mixing several element types evaluates them
+ * only once per combination, rather than every time consecutive
+ * elements differ in type.
+ *
+ * Entries are shared: an \p FE object keeps the entry its arrays were
+ * last filled from, and only copies from the cache when it moves to a
+ * different entry.  Entries stay valid for their holders after being
+ * replaced or evicted.
+ *
+ * Each thread has its own cache, so no locking is needed.  The cache
+ * is emptied whenever it would exceed \p max_entries, which bounds
+ * its size when reinit() is given many distinct custom point sets.
+ *
+ * \date 2025
+ * \brief Per-thread cache of reference element shape functions.
+ */
+template <typename OutputShape>
+class ReferenceShapeCache
+{
+public:
+  typedef std::vector<std::vector<OutputShape>> ShapeArray;
+
+  /**
+   * The reference data for one key.
+   */
+  struct Entry
+  {
+    std::vector<Point> points;
+
+    bool has_phi = false;
+    bool has_first = false;
+    bool has_second = false;
+
+    /**
+     * Shape function values, for families whose values on physical
+     * elements are their values on the reference element.
+     */
+    ShapeArray phi;
+
+    /**
+     * First derivatives with respect to xi, eta, and zeta.
+     */
+    ShapeArray first[3];
+
+    /**
+     * Second derivatives, in the order used by \p
+     * shape_second_deriv(): xixi, xieta, etaeta, xizeta, etazeta,
+     * zetazeta.
+     */
+    ShapeArray second[6];
+  };
+
+  /**
+   * The largest number of entries we will store at once.
+   */
+  static const std::size_t max_entries = 256;
+
+  /**
+   * \returns The cache for the calling thread.
+   */
+  static ReferenceShapeCache & thread_cache ()
+  {
+    static thread_local ReferenceShapeCache cache;
+    return cache;
+  }
+
+  /**
+   * \returns The entry evaluated at \p points for the given key, with
+   * values and first and/or second derivatives if requested, or \p
+   * nullptr if there is no such entry.
+   */
+  std::shared_ptr<const Entry> find (const FEType & fe_type,
+                                     ElemType elem_type,
+                                     unsigned int p_level,
+                                     const std::vector<Point> & points,
+                                     bool need_phi,
+                                     bool need_first,
+                                     bool need_second)
+  {
+    auto it = _entries.find(Key(fe_type, elem_type, p_level, points.size()));
+    if (it != _entries.end())
+      for (const auto & entry : it->second)
+        if (entry->points == points &&
+            (entry->has_phi || !need_phi) &&
+            (entry->has_first || !need_first) &&
+            (entry->has_second || !need_second))
+          {
+            ++_n_hits;
+            return entry;
+          }
+
+    ++_n_misses;
+    return nullptr;
+  }
+
+  /**
+   * \returns A new entry for \p points and the given key, replacing
+   * any previous entry for the same points, for the caller to fill
+   * in.
+   */
+  std::shared_ptr<Entry> insert (const FEType & fe_type,
+                                 ElemType elem_type,
+                                 unsigned int p_level,
+                                 const std::vector<Point> & points)
+  {
+    if (_n_entries >= max_entries)
+      this->clear();
+
+    std::vector<std::shared_ptr<Entry>> & entries =
+      _entries[Key(fe_type, elem_type, p_level, points.size())];
+
+    auto it = std::find_if(entries.begin(), entries.end(),
+                           [&points](const std::shared_ptr<Entry> & entry)
+                           { return entry->points == points; });
+
+    if (it == entries.end())
+      {
+        ++_n_entries;
+        it = entries.emplace(entries.end());
+      }
+
+    *it = std::make_shared<Entry>();
+    (*it)->points = points;
+    return *it;
+  }
+
+  /**
+   * Empties the cache.
+   */
+  void clear ()
+  {
+    _entries.clear();
+    _n_entries = 0;
+  }
+
+  std::size_t n_entries () const { return _n_entries; }
+
+  std::size_t n_hits () const { return _n_hits; }
+
+  std::size_t n_misses () const { return _n_misses; }
+
+private:
+
+  ReferenceShapeCache () = default;
+
+  typedef std::tuple<FEType, ElemType, unsigned int, std::size_t> Key;
+
+  std::map<Key, std::vector<std::shared_ptr<Entry>>> _entries;
+
+  std::size_t _n_entries = 0;
+
+  std::size_t _n_hits = 0;
+
+  std::size_t _n_misses = 0;
+};
+
+} // namespace libMesh
+
+#endif // LIBMESH_REFERENCE_SHAPE_CACHE_H
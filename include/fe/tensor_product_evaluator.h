@@ -0,0 +1,303 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2025 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_TENSOR_PRODUCT_EVALUATOR_H
+#define LIBMESH_TENSOR_PRODUCT_EVALUATOR_H
+
+// Local includes
+#include "libmesh/libmesh_common.h"
+#include "libmesh/enum_elem_type.h"
+#include "libmesh/fe_type.h"
+#include "libmesh/point.h"
+
+// C++ includes
+#include <array>
+#include <cstdint>
+#include <map>
+#include <vector>
+
+namespace libMesh
+{
+
+// Forward declarations
+class Elem;
+class QBase;
+template <typename T> class DenseVectorBase;
+
+/**
+ * Sum-factorized evaluation of finite element fields whose basis is
+ * a tensor product of one-dimensional bases, at the points of a
+ * tensor product quadrature rule.
+ *
+ * Rather than evaluating every shape function at every quadrature
+ * point, 1D shape function tables are applied one dimension at a
+ * time, so interpolating a field or its reference gradient costs
+ * O(p^(d+1)) operations per element instead of O(p^(2d)).  The
+ * transposed operations, \p integrate() and \p integrate_gradient(),
+ * test quadrature point data against every shape function at the same
+ * cost, for matrix-free residual evaluation.
+ *
+ * LAGRANGE, L2_LAGRANGE, HIERARCHIC, L2_HIERARCHIC and BERNSTEIN
+ * bases are supported on edges, quadrilaterals and hexahedra wherever
+ * they span the full tensor product space, e.g. at any order on
+ * QUAD9 and HEX27 for the hierarchic bases.  Hierarchic and Bernstein
+ * shape functions depend on the orientation of element edges and
+ * faces: each one is a product of 1D shape functions with the
+ * coordinates flipped or swapped, i.e. plus or minus some entry of
+ * the 1D tensor product.  \p reinit() finds that signed permutation
+ * for each element.  Since orientations only depend on the ordering
+ * of an element's vertices, permutations are found once per vertex
+ * ordering, by expanding each shape function in the tensor product
+ * basis, and cached.  The expansion is exact, so an element whose shape
+ * functions are not signed tensor product entries is an error rather
+ * than a near match.
+ *
+ * Gradients and fluxes here are with respect to reference
+ * coordinates; combining them with the inverse map Jacobian (e.g. \p
+ * FEMap::get_dxidx()) is left to the caller.
+ *
+ * \p FE::reinit() uses an evaluator to fill \p phi and the reference
+ * shape derivatives when \p FEAbstract::enable_tensor_product_evaluation()
+ * has been called, and \p FEMContext then uses it for interior values
+ * and gradients.
+ *
+ * Evaluators keep scratch storage, so each thread should use its own.
+ *
+ * \date 2025
+ * \brief Sum-factorization kernels for tensor product elements.
+ */
+class TensorProductEvaluator
+{
+public:
+  /**
+   * \returns \p true if the \p fe_type basis on \p elem_type elements
+   * is a tensor product we can factor, and \p qrule (which must
+   * already be initialized) is a tensor product rule.
+   */
+  static bool supports (const FEType & fe_type,
+                        ElemType elem_type,
+                        const QBase & qrule);
+
+  /**
+   * \returns \p true if the \p fe_type basis on \p elem_type elements
+   * is a tensor product we can factor, and \p points (in reference
+   * coordinates) have tensor product structure.
+   */
+  static bool supports (const FEType & fe_type,
+                        ElemType elem_type,
+                        const std::vector<Point> & points);
+
+  /**
+   * Constructor.  Builds the 1D shape function tables for \p fe_type
+   * on \p elem_type at the points of \p qrule.  \p supports() must be
+   * true for these arguments.
+   */
+  TensorProductEvaluator (const FEType & fe_type,
+                          ElemType elem_type,
+                          const QBase & qrule);
+
+  /**
+   * Constructor.  Builds the 1D shape function tables for \p fe_type
+   * on \p elem_type at \p points.  \p supports() must be true for
+   * these arguments.
+   */
+  TensorProductEvaluator (const FEType & fe_type,
+                          ElemType elem_type,
+                          const std::vector<Point> & points);
+
+  /**
+   * Evaluators point into their own cache, and cannot be copied.
+   */
+  TensorProductEvaluator (const TensorProductEvaluator &) = delete;
+  TensorProductEvaluator & operator= (const TensorProductEvaluator &) = delete;
+
+  /**
+   * \returns \p true if this evaluator was built for \p fe_type on \p
+   * elem_type at \p points.
+   */
+  bool matches (const FEType & fe_type,
+                ElemType elem_type,
+                const std::vector<Point> & points) const;
+
+  /**
+   * Prepares for evaluation on \p elem, which must be of the element
+   * type we were built for, by selecting the dof signs and
+   * permutation for its edge and face orientations.  Until this is
+   * first called, the orientation of the reference element is used.
+   */
+  void reinit (const Elem & elem);
+
+  unsigned int dim () const { return _dim; }
+
+  /**
+   * \returns The number of shape functions.
+   */
+  unsigned int n_dofs () const { return cast_int<unsigned int>(_reference_perm.lex.size()); }
+
+  /**
+   * \returns The number of quadrature points.
+   */
+  unsigned int n_points () const { return _n_points; }
+
+  /**
+   * Fills \p phi[i][qp] with the value of shape function \p i at each
+   * point.  This is an outer product of the 1D tables, so it costs
+   * one multiply per dimension per entry, with no calls to the shape
+   * functions themselves.
+   */
+  void shapes (std::vector<std::vector<Real>> & phi) const;
+
+  /**
+   * Fills \p dphi[i][qp] with the derivative of shape function \p i
+   * with respect to reference coordinate \p d at each point.
+   */
+  void shape_derivs (unsigned int d,
+                     std::vector<std::vector<Real>> & dphi) const;
+
+  /**
+   * Computes \p values[qp] = sum_i coefs(i) phi_i(qp).
+   */
+  void interpolate (const DenseVectorBase<Number> & coefs,
+                    std::vector<Number> & values) const;
+
+  /**
+   * Computes \p ref_grad[d][qp] = sum_i coefs(i) dphi_i/dxi_d(qp), for
+   * each reference direction \p d.
+   */
+  void interpolate_gradient (const DenseVectorBase<Number> & coefs,
+                             std::vector<std::vector<Number>> & ref_grad) const;
+
+  /**
+   * Adds sum_qp values[qp] phi_i(qp) to \p residual(i).  Quadrature
+   * weights, if wanted, should already be included in \p values.
+   */
+  void integrate (const std::vector<Number> & values,
+                  DenseVectorBase<Number> & residual) const;
+
+  /**
+   * Adds sum_qp sum_d ref_flux[d][qp] dphi_i/dxi_d(qp) to \p
+   * residual(i).
+   */
+  void integrate_gradient (const std::vector<std::vector<Number>> & ref_flux,
+                           DenseVectorBase<Number> & residual) const;
+
+private:
+
+  typedef std::array<unsigned int, 3> Dims;
+
+  /**
+   * Each shape function is \p sign times the entry \p lex of the
+   * tensor product of 1D shape functions, lexicographically ordered
+   * with the first 1D index fastest.
+   */
+  struct SignedPermutation
+  {
+    std::vector<unsigned int> lex;
+    std::vector<Real> sign;
+  };
+
+  /**
+   * Finds the signed permutation of shape functions on \p elem, by
+   * interpolating each at the tensor product of \p _nodes1 and
+   * applying \p _coef1 in every direction.
+   */
+  void build_permutation (const Elem & elem, SignedPermutation & perm) const;
+
+  /**
+   * \returns A key identifying the ordering of the vertices of \p
+   * elem, on which all edge and face orientations depend.
+   */
+  static std::uint64_t vertex_ordering_key (const Elem & elem);
+
+  /**
+   * Contracts each of the first \p _dim directions of \p in (with
+   * dimensions \p in_dims, first index fastest) against the row-major
+   * matrix \p mats[d], which has \p out_dims[d] rows, and writes the
+   * result to \p out.
+   */
+  void apply (const std::array<const std::vector<Real> *, 3> & mats,
+              const Dims & in_dims,
+              const Dims & out_dims,
+              const std::vector<Number> & in,
+              std::vector<Number> & out) const;
+
+  /**
+   * Fills \p out[i][qp] with the outer product of the row-major \p
+   * _nq1 by \p _n1 tables \p mats[d], signed and permuted per \p
+   * _current.
+   */
+  void outer_product (const std::array<const std::vector<Real> *, 3> & mats,
+                      std::vector<std::vector<Real>> & out) const;
+
+  FEType _fe_type;
+
+  ElemType _elem_type;
+
+  unsigned int _dim;
+
+  /**
+   * Number of 1D shape functions and of 1D quadrature points.
+   */
+  unsigned int _n1, _nq1;
+
+  unsigned int _n_points;
+
+  /**
+   * The points we were built for, so \p matches() can check them.
+   */
+  std::vector<Point> _points;
+
+  /**
+   * 1D shape function values and derivatives, as row-major \p _nq1 by
+   * \p _n1 matrices, and their transposes.
+   */
+  std::vector<Real> _phi1, _dphi1, _phi1_t, _dphi1_t;
+
+  /**
+   * \p _n1 distinct 1D points, and the inverse of the 1D shape
+   * functions' values there as a row-major matrix, which maps values
+   * at those points to coefficients in the 1D basis.
+   */
+  std::vector<Real> _nodes1, _coef1;
+
+  /**
+   * The permutation on the reference element, used by every element
+   * of a family which does not depend on orientation.
+   */
+  SignedPermutation _reference_perm;
+
+  /**
+   * Permutations found for each vertex ordering seen so far.
+   */
+  std::map<std::uint64_t, SignedPermutation> _perms;
+
+  /**
+   * The permutation for the current element.
+   */
+  const SignedPermutation * _current;
+
+  /**
+   * Scratch space.
+   */
+  mutable std::vector<Number> _lex, _work, _work2;
+};
+
+} // namespace libMesh
+
+#endif // LIBMESH_TENSOR_PRODUCT_EVALUATOR_H
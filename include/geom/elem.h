@@ -34,6 +34,7 @@
 #include "libmesh/simple_range.h"
 #include "libmesh/variant_filter_iterator.h"
 #include "libmesh/hashword.h" // Used in compute_key() functions
+#include "libmesh/pooled_object.h"
 
 // C++ includes
 #include <algorithm>
@@ -87,12 +88,16 @@ enum Order : int;
  * Hex8 is a 3D hexahedral element. A \p Hex8 has 6 sides, which are
  * \p Faces of type Quad4.
  *
+ * Elements built by a mesh with pooled allocation enabled are drawn
+ * from slab pools owned by that mesh; see \p PooledObject.
+ *
  * \author Benjamin S. Kirk
  * \date 2002-2007
  * \brief The base class for all geometric element types.
  */
 class Elem : public ReferenceCountedObject<Elem>,
-             public DofObject
+             public DofObject,
+             public PooledObject<Elem>
 {
 protected:
 
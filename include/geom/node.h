@@ -24,6 +24,7 @@
 #include "libmesh/point.h"
 #include "libmesh/dof_object.h"
 #include "libmesh/reference_counted_object.h"
+#include "libmesh/pooled_object.h"
 
 // C++ includes
 #include <iostream>
@@ -45,13 +46,17 @@ class MeshRefinement;
  * global \p id.  Finally, a \p Node may have an arbitrary number of
  * degrees of freedom associated with it.
  *
+ * Nodes built by a mesh with pooled allocation enabled are drawn from
+ * slab pools owned by that mesh; see \p PooledObject.
+ *
  * \author Benjamin S. Kirk
  * \date 2003
  * \brief A geometric point in (x,y,z) space associated with a DOF.
  */
 class Node : public Point,
              public DofObject,
-             public ReferenceCountedObject<Node>
+             public ReferenceCountedObject<Node>,
+             public PooledObject<Node>
 {
 
 public:
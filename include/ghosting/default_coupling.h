@@ -78,6 +78,10 @@ public:
   // Change coupling matrix after construction
   void set_dof_coupling(const CouplingMatrix * dof_coupling);
 
+  // Return the coupling matrix, or nullptr for full coupling.
+  const CouplingMatrix * dof_coupling() const
+  { return _dof_coupling; }
+
   // Return number of levels of neighbors we will couple.
   unsigned int n_levels()
   { return _n_levels; }
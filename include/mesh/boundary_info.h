@@ -31,6 +31,7 @@
 #include <set>
 #include <vector>
 #include <tuple>
+#include <unordered_map>
 
 namespace libMesh
 {
@@ -941,8 +942,84 @@ public:
   void allow_children_on_boundary_side(const bool children_on_boundary)
   { _children_on_boundary = children_on_boundary; }
 
+  /**
+   * Builds read-only, id-indexed copies of the side, edge, and node
+   * boundary id maps, with which looking up the boundary ids of an
+   * object takes O(1) time rather than a search of a multimap.
+   *
+   * This is done by \p MeshBase::prepare_for_use(); any subsequent
+   * modification of a map discards the corresponding copy, and
+   * lookups fall back on the map until \p freeze() is called again.
+   * Object ids must not change while frozen; the mesh renumbering
+   * methods \p thaw() us.
+   */
+  void freeze ();
+
+  /**
+   * Discards the copies made by \p freeze().
+   */
+  void thaw ();
+
+  /**
+   * \returns \p true if side, edge, and node boundary id lookups are
+   * all currently done via the copies made by \p freeze().
+   */
+  bool is_frozen () const
+  { return _frozen_side_id.valid && _frozen_edge_id.valid && _frozen_node_id.valid; }
+
 private:
 
+  /**
+   * A read-only copy of one of our boundary id multimaps, indexed by
+   * DofObject id in compressed row form: the values for row \p r are
+   * \p values[offsets[r]] through \p values[offsets[r+1]-1], in
+   * multimap order.
+   *
+   * Row \p r usually belongs to the object with id \p first_id + r,
+   * the dense local offset of its id.  If the stored ids are too
+   * sparse for that to be economical, e.g. on a distributed mesh,
+   * each stored object instead gets a row of its own, found via \p
+   * sparse_rows.  Either way a lookup takes O(1) time.
+   */
+  template <typename Value>
+  struct FrozenMap
+  {
+    /**
+     * Replaces our contents with those of \p map.
+     */
+    template <typename Key>
+    void build (const std::multimap<const Key *, Value> & map);
+
+    /**
+     * Discards our contents.
+     */
+    void clear ();
+
+    /**
+     * Calls \p f on each value associated with \p obj, using our
+     * contents if valid or \p map (which must be what we were built
+     * from, if valid) otherwise.
+     */
+    template <typename Key, typename Func>
+    void for_each (const std::multimap<const Key *, Value> & map,
+                   const Key * obj,
+                   Func f) const;
+
+    bool valid = false;
+
+    dof_id_type first_id = 0;
+
+    /**
+     * The row of each object with values, if we aren't indexing rows
+     * by dense id offsets.
+     */
+    std::unordered_map<dof_id_type, std::size_t> sparse_rows;
+
+    std::vector<std::size_t> offsets;
+
+    std::vector<Value> values;
+  };
+
   /**
    * Helper method for ensuring that our multimaps don't contain
    * entries with duplicate keys *and* values.  Probably should have
@@ -999,6 +1076,17 @@ private:
                 std::pair<unsigned short int, boundary_id_type>>
   _boundary_side_id;
 
+  /**
+   * Frozen copies of \p _boundary_node_id, \p _boundary_edge_id,
+   * and \p _boundary_side_id, valid only while the mesh is unmodified
+   * since \p freeze().
+   */
+  FrozenMap<boundary_id_type> _frozen_node_id;
+
+  FrozenMap<std::pair<unsigned short int, boundary_id_type>> _frozen_edge_id;
+
+  FrozenMap<std::pair<unsigned short int, boundary_id_type>> _frozen_side_id;
+
   /*
    * Whether or not children elements are associated with any boundary
    * It is false by default. The flag will be turned on if `add_side`
@@ -30,6 +30,7 @@
 #include "libmesh/variant_filter_iterator.h"
 #include "libmesh/parallel_object.h"
 #include "libmesh/simple_range.h"
+#include "libmesh/threads.h"
 
 // C++ Includes
 #include <cstddef>
@@ -53,6 +54,7 @@ namespace libMesh
 class Elem;
 class GhostingFunctor;
 class Node;
+class ObjectArena;
 class Point;
 class Partitioner;
 class BoundaryInfo;
@@ -66,6 +68,11 @@ enum ElemMappingType : unsigned char;
 template <class MT>
 class MeshInput;
 
+namespace MeshTools
+{
+class NodeElemConnectivity;
+}
+
 
 /**
  * This is the \p MeshBase class. This class provides all the data necessary
@@ -241,7 +248,7 @@ public:
    * generally more efficient to mark finer-grained settings instead.
    */
   void unset_is_prepared()
-  { _preparation = false; }
+  { _preparation = false; this->clear_node_elem_connectivity(); }
 
   /**
    * Tells this we have done some operation creating unpartitioned
@@ -1367,6 +1374,36 @@ public:
   void allow_remote_element_removal(bool allow) { _allow_remote_element_removal = allow; }
   bool allow_remote_element_removal() const { return _allow_remote_element_removal; }
 
+  /**
+   * If \p true is passed then nodes and elements this mesh builds from
+   * now on, e.g. in \p add_point(), refinement, mesh generation or
+   * redistribution, are allocated from slab pools owned by this mesh,
+   * one per object size, rather than individually from the heap.
+   * Memory is then returned to the system in bulk, as remote elements
+   * are deleted and when the mesh is cleared or destroyed.
+   *
+   * This is false by default, unless the \p --pool-mesh-objects
+   * command line option is given.  Objects already allocated are
+   * unaffected by the setting, so it may be changed at any time.
+   */
+  void enable_pooled_allocation(bool enable = true);
+  bool pooled_allocation_enabled() const { return _pooled_allocation; }
+
+  /**
+   * \returns The arena new nodes and elements of this mesh are
+   * allocated from, or \p nullptr if pooled allocation is disabled.
+   * Code building objects for this mesh can make it current with an
+   * \p ObjectArena::Scope; such objects must not outlive the mesh.
+   */
+  ObjectArena * object_arena() const
+  { return _pooled_allocation ? _object_arena.get() : nullptr; }
+
+  /**
+   * \returns The number of objects currently allocated from this
+   * mesh's arena.
+   */
+  std::size_t n_pooled_objects() const;
+
   /**
    * If \p true is passed, then this mesh will no longer require
    * unique_ids to be unique across the set of all DofObjects. That
@@ -1376,6 +1413,30 @@ public:
   void allow_node_and_elem_unique_id_overlap(bool allow) { _allow_node_and_elem_unique_id_overlap = allow; }
   bool allow_node_and_elem_unique_id_overlap() const { return _allow_node_and_elem_unique_id_overlap; }
 
+  /**
+   * If \p true is passed, then each \p DofMap::distribute_dofs() on
+   * this mesh will finish by calling \p compact_dof_object_indexing(),
+   * so that the DoF indices of all nodes and elements are stored in
+   * one contiguous buffer rather than in one heap allocation per
+   * object.
+   *
+   * This is false by default.
+   */
+  void compact_dof_indexing(bool compact) { _compact_dof_indexing = compact; }
+  bool compact_dof_indexing() const { return _compact_dof_indexing; }
+
+  /**
+   * Packs the DoF indexing data of every node and element on this
+   * processor into a single mesh-owned buffer, in element order with
+   * each element's nodes immediately preceding it, so lookups of the
+   * DoF indices on an element touch nearby memory.
+   *
+   * Objects whose indexing later changes size (e.g. when a system is
+   * added) quietly move back to separate storage; calling this again
+   * repacks everything.
+   */
+  void compact_dof_object_indexing();
+
   /**
    * If true is passed in then the elements on this mesh will no
    * longer be (re)partitioned, and the nodes on this mesh will only
@@ -1664,6 +1725,30 @@ public:
    */
   void clear_point_locator ();
 
+  /**
+   * \returns The elements touching each node of this processor's copy
+   * of the mesh, building and caching the map first if necessary.
+   * The cache is released when elements or nodes are added, inserted,
+   * deleted or renumbered, when the mesh is redistributed or
+   * prepared, when it is marked as unprepared, or by
+   * clear_node_elem_connectivity().  Code which changes the nodes of
+   * an existing element must release it.
+   *
+   * Concurrent calls are safe, but the map must already have been
+   * built before any call from threaded code, since building it
+   * spawns threads of its own.
+   *
+   * The map holds one entry per (node, element) connection for as
+   * long as it is cached; library code which only needs it briefly
+   * builds its own MeshTools::NodeElemConnectivity instead.
+   */
+  const MeshTools::NodeElemConnectivity & node_elem_connectivity () const;
+
+  /**
+   * Releases the cached node-to-element map.
+   */
+  void clear_node_elem_connectivity ();
+
   /**
    * In the point locator, do we count lower dimensional elements
    * when we refine point locator regions? This is relevant in
@@ -2154,6 +2239,17 @@ protected:
    */
   mutable std::unique_ptr<PointLocatorBase> _point_locator;
 
+  /**
+   * The cached node-to-element map, if node_elem_connectivity() has
+   * been called since the mesh was last modified.
+   */
+  mutable std::unique_ptr<MeshTools::NodeElemConnectivity> _node_elem_connectivity;
+
+  /**
+   * Guards the lazy build of \p _node_elem_connectivity.
+   */
+  mutable Threads::spin_mutex _node_elem_connectivity_mutex;
+
   /**
    * Do we count lower dimensional elements in point locator refinement?
    * This is relevant in tree-based point locators, for example.
@@ -2212,6 +2308,19 @@ protected:
    */
   bool _allow_remote_element_removal;
 
+  /**
+   * If this is true then new nodes and elements are allocated from
+   * \p _object_arena.
+   */
+  bool _pooled_allocation;
+
+  /**
+   * The slab pools our nodes and elements are allocated from, if
+   * pooled allocation has ever been enabled.  Our subclasses delete
+   * every node and element before this is destroyed.
+   */
+  std::unique_ptr<ObjectArena> _object_arena;
+
   /**
    * The Exodus reader (and potentially other readers in the future?)
    * now supports setting Node and Elem unique_ids based on values
@@ -2225,6 +2334,18 @@ protected:
    */
   bool _allow_node_and_elem_unique_id_overlap;
 
+  /**
+   * If this is true then DoF indexing is packed into \p
+   * _dof_index_pool after each DoF distribution.
+   */
+  bool _compact_dof_indexing;
+
+  /**
+   * Shared storage for the DoF indexing of our nodes and elements,
+   * when \p compact_dof_object_indexing() has been used.
+   */
+  std::vector<dof_id_type> _dof_index_pool;
+
   /**
    * This structure maintains the mapping of named blocks
    * for file formats that support named blocks.  Currently
@@ -29,12 +29,16 @@
 // Local Includes
 #include "libmesh/libmesh_common.h"
 #include "libmesh/libmesh.h" // libMesh::invalid_uint
+#include "libmesh/point.h"
 #include "libmesh/topology_map.h"
 #include "libmesh/parallel_object.h"
+#include "libmesh/node_elem_connectivity.h"
 
 // C++ Includes
 #include <vector>
 
+class MeshBaseTest;
+
 namespace libMesh
 {
 
@@ -491,6 +495,22 @@ public:
    */
   bool & allow_unrefined_patches();
 
+  /**
+   * If \p threaded_refinement is set to true, h refinement first
+   * works out where every node of every new child element goes
+   * (which parent node or bracketing node pair it corresponds to, and
+   * its location) on all threads, and then adds the children and
+   * their new nodes to the mesh in the usual order, so the refined
+   * mesh, including its node and element ids, is identical to that
+   * of serial refinement.
+   *
+   * Coarsening, which mostly updates neighbor links and boundary
+   * data shared between elements, is not threaded.
+   *
+   * \p threaded_refinement is false by default.
+   */
+  bool & threaded_refinement();
+
   /**
    * Copy refinement flags on ghost elements from their
    * local processors.
@@ -609,9 +629,30 @@ private:
    * o-------o-------o-------o-------o
    * \endverbatim
    * by refining the indicated element
+   *
+   * Unless the mismatch limit is being enforced prior to refinement,
+   * newly flagged elements are propagated through a worklist, so
+   * a single call leaves no violations of the node mismatch limit
+   * and later sweeps of \p _smooth_flags only need to recheck it.
    */
   bool limit_level_mismatch_at_node (const unsigned int max_mismatch);
 
+  /**
+   * Flags active elements for h and/or p refinement until none
+   * violates \p max_mismatch at any node.  After one threaded pass
+   * over the active elements, only those sharing a node with a newly
+   * flagged element are rechecked.  Works on this processor's copy
+   * of the mesh only.
+   *
+   * The active elements and node levels are kept for later calls in
+   * the same \p _smooth_flags pass, whose other smoothing steps only
+   * ever add refinement flags; the threaded pass of a later call
+   * picks up elements they raised.
+   *
+   * \returns \p true if any flags changed here.
+   */
+  bool propagate_level_mismatch_at_node (const unsigned int max_mismatch);
+
   /*
    * This algorithm restricts the maximum level mismatch
    * at any edge in the mesh.  See the ASCII art in the comment of
@@ -785,6 +826,64 @@ private:
 
   bool _allow_unrefined_patches;
 
+  bool _threaded_refinement;
+
+  /**
+   * Where one node of one child of a refined element belongs: the
+   * parent node it coincides with, or otherwise the pairs of parent
+   * nodes (by local index, in the element type's cached table)
+   * bracketing it and its location.  If neither is set, as for
+   * non-full-order elements whose bracketing nodes can only be found
+   * from the children already built, add_node() works it out itself.
+   */
+  struct ChildNodePlacement
+  {
+    unsigned int parent_node;
+    const std::vector<std::pair<unsigned char, unsigned char>> * parent_bracketing_nodes;
+    Point p;
+  };
+
+  /**
+   * Fills \p layout with the parent node or parent bracketing nodes
+   * of every child node of an element like \p parent, at index child
+   * number times \p parent.n_nodes() plus child node number.  This
+   * depends only on the element type and embedding matrix version,
+   * and reads Elem caches which take a global lock.
+   */
+  static void child_node_layout (const Elem & parent,
+                                 std::vector<ChildNodePlacement> & layout);
+
+  /**
+   * Finds the placement of every child node of \p parent, from the
+   * \p layout of its type, writing to \p placements at the same
+   * indices.  This takes no locks.
+   */
+  static void place_child_nodes (const Elem & parent,
+                                 const ChildNodePlacement * layout,
+                                 ChildNodePlacement * placements);
+
+  /**
+   * \returns The location of node \p node of child \p child of \p
+   * parent, from the embedding matrix.
+   */
+  static Point child_node_point (const Elem & parent,
+                                 unsigned int child,
+                                 unsigned int node);
+
+  /**
+   * Adds a node at \p p, between \p bracketing_nodes, to the mesh
+   * and to the \p _new_nodes_map.
+   */
+  Node * add_new_node (const Point & p,
+                       const std::vector<std::pair<dof_id_type, dof_id_type>> & bracketing_nodes,
+                       processor_id_type proc_id);
+
+  /**
+   * The child node placements for the element being refined, if they
+   * were found ahead of time, for add_node() to use.
+   */
+  const ChildNodePlacement * _child_node_placements;
+
   /**
    * This option enforces the mismatch level prior to refinement by checking
    * if refining any element marked for refinement \b would cause a mismatch
@@ -872,6 +971,24 @@ private:
 #ifdef LIBMESH_ENABLE_PERIODIC
   PeriodicBoundaries * _periodic_boundaries;
 #endif
+
+  /**
+   * The active elements, the elements touching each node, and the
+   * maximum level and p level (counting refinement flags) of the
+   * active elements touching each node, kept by \p
+   * propagate_level_mismatch_at_node() between its calls within one
+   * \p _smooth_flags pass.  Empty when not in use.
+   */
+  std::vector<Elem *> _smoothing_active_elems;
+  MeshTools::NodeElemConnectivity _smoothing_nodes_to_elem;
+  std::vector<unsigned char> _max_level_at_node, _max_p_level_at_node;
+
+  /**
+   * Clears the data above.
+   */
+  void clear_smoothing_node_levels ();
+
+  friend class ::MeshBaseTest;
 };
 
 
@@ -951,6 +1068,11 @@ inline bool & MeshRefinement::allow_unrefined_patches()
   return _allow_unrefined_patches;
 }
 
+inline bool & MeshRefinement::threaded_refinement()
+{
+  return _threaded_refinement;
+}
+
 inline bool & MeshRefinement::enforce_mismatch_limit_prior_to_refinement()
 {
   return _enforce_mismatch_limit_prior_to_refinement;
@@ -53,6 +53,9 @@ enum ElemType : int;
 namespace MeshTools
 {
 
+// Forward declarations
+class NodeElemConnectivity;
+
 /**
  * \returns The sum over all the elements of the number
  * of nodes per element.
@@ -347,6 +350,16 @@ void find_nodal_neighbors(const MeshBase & mesh,
                           const std::unordered_map<dof_id_type, std::vector<const Elem *>> & nodes_to_elem_map,
                           std::vector<const Node *> & neighbors);
 
+/**
+ * Given a mesh and a node in the mesh, the vector will be filled with
+ * every node directly attached to the given one.  The compressed
+ * \p node_elem_connectivity is typically MeshBase::node_elem_connectivity().
+ */
+void find_nodal_neighbors(const MeshBase & mesh,
+                          const Node & n,
+                          const NodeElemConnectivity & node_elem_connectivity,
+                          std::vector<const Node *> & neighbors);
+
 /**
  * Given a mesh and a node in the mesh, the vector will be filled with
  * every node directly attached to the given one. IF NO nodal neighbors are found,
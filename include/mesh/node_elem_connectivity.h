@@ -0,0 +1,123 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2025 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+#ifndef LIBMESH_NODE_ELEM_CONNECTIVITY_H
+#define LIBMESH_NODE_ELEM_CONNECTIVITY_H
+
+// libMesh includes
+#include "libmesh/id_types.h" // dof_id_type
+#include "libmesh/simple_range.h"
+
+// C++ includes
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace libMesh
+{
+
+// Forward declarations
+class MeshBase;
+class Elem;
+class Node;
+
+namespace MeshTools
+{
+
+/**
+ * The elements touching each node of a mesh, as
+ * MeshTools::build_nodes_to_elem_map() gives them, but stored in
+ * compressed rows: one offset per node into a single flat array of
+ * element pointers, rather than one heap-allocated vector per node.
+ *
+ * The rows are filled by counting elements per node, taking a prefix
+ * sum of the counts, and then scattering elements into place, with
+ * both passes over the elements split between threads.  Each row
+ * lists its elements in order of increasing id.
+ *
+ * MeshBase::node_elem_connectivity() caches one of these for shared
+ * use until the mesh is next modified.
+ *
+ * \date 2025
+ * \brief Compressed node-to-element adjacency.
+ */
+class NodeElemConnectivity
+{
+public:
+  /**
+   * Default constructor, for an empty map.
+   */
+  NodeElemConnectivity ();
+
+  /**
+   * Builds the map for every element (active or not) of \p mesh
+   * which is local to this processor's copy of the mesh.
+   */
+  static NodeElemConnectivity build (const MeshBase & mesh);
+
+  /**
+   * Typedef for the iterators over a node's elements.
+   */
+  typedef std::vector<const Elem *>::const_iterator ElemIter;
+
+  /**
+   * \returns The range of elements touching the node with id
+   * \p node_id, which is empty if the node isn't in the map.
+   */
+  SimpleRange<ElemIter> connected_elems (dof_id_type node_id) const;
+
+  /**
+   * \returns The range of elements touching \p node.
+   */
+  SimpleRange<ElemIter> connected_elems (const Node & node) const;
+
+  /**
+   * \returns The total number of (node, element) connections.
+   */
+  std::size_t n_connections () const { return _elems.size(); }
+
+private:
+
+  /**
+   * \returns The row of node \p node_id, or an invalid id if it has
+   * none.
+   */
+  dof_id_type row (dof_id_type node_id) const;
+
+  /**
+   * A serial mesh gets one row per node id.  Otherwise ids can be
+   * sparse, and rows are numbered compactly via this map.
+   */
+  bool _rows_are_node_ids;
+
+  std::unordered_map<dof_id_type, dof_id_type> _node_rows;
+
+  /**
+   * The start of each row in \p _elems, plus one final end offset.
+   * The number of connections can outgrow \p dof_id_type even when
+   * node and element ids don't.
+   */
+  std::vector<std::size_t> _offsets;
+
+  std::vector<const Elem *> _elems;
+};
+
+} // namespace MeshTools
+
+} // namespace libMesh
+
+#endif // LIBMESH_NODE_ELEM_CONNECTIVITY_H
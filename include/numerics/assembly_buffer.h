@@ -0,0 +1,152 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2025 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_ASSEMBLY_BUFFER_H
+#define LIBMESH_ASSEMBLY_BUFFER_H
+
+// Local includes
+#include "libmesh/libmesh_common.h"
+#include "libmesh/id_types.h"
+#include "libmesh/threads.h"
+
+// C++ includes
+#include <vector>
+
+namespace libMesh
+{
+
+// Forward declarations
+template <typename T> class DenseMatrix;
+template <typename T> class DenseVector;
+template <typename T> class NumericVector;
+template <typename T> class SparseMatrix;
+
+/**
+ * Stages element contributions to a global sparse matrix and vector
+ * as (row, column, value) and (index, value) triplets, for one thread
+ * to insert in large batches.
+ *
+ * Each flush() sorts the staged entries, sums duplicates (typically
+ * contributions to one dof from several elements), and gathers
+ * consecutive rows with the same columns into dense blocks.  Only
+ * then is the optional mutex taken, once, while the blocks are added
+ * to the matrix with one \p add_matrix() call each and to the vector
+ * with a single \p add_vector() call.  This replaces per-element
+ * locking and insertion calls in threaded assembly loops; each thread
+ * should own its own buffer.
+ *
+ * Entries are flushed automatically once more than \p max_entries
+ * are staged, and must be flushed explicitly at the end of assembly.
+ *
+ * \date 2025
+ * \brief Thread-local staging of global matrix and vector insertions.
+ */
+template <typename T>
+class AssemblyBuffer
+{
+public:
+  /**
+   * Constructor.  Either of \p matrix or \p vector may be null if
+   * only the other is to be assembled.  If \p mutex is provided, it
+   * is held while flushing.
+   */
+  AssemblyBuffer (SparseMatrix<T> * matrix,
+                  NumericVector<T> * vector,
+                  Threads::spin_mutex * mutex = nullptr,
+                  std::size_t max_entries = 1 << 20);
+
+  /**
+   * Special functions.
+   * - The buffer holds pointers to its targets, and staged entries
+   *   should not be duplicated, so it can't be copied.
+   */
+  AssemblyBuffer (const AssemblyBuffer &) = delete;
+  AssemblyBuffer & operator= (const AssemblyBuffer &) = delete;
+  AssemblyBuffer (AssemblyBuffer &&) = default;
+  AssemblyBuffer & operator= (AssemblyBuffer &&) = default;
+
+  /**
+   * Destructor.  Entries should have been flushed, unless the buffer
+   * is destroyed by an exception, in which case they are discarded.
+   */
+  ~AssemblyBuffer ();
+
+  /**
+   * Stages the addition of \p dm to the matrix rows \p rows and
+   * columns \p cols.
+   */
+  void add_matrix (const DenseMatrix<T> & dm,
+                   const std::vector<numeric_index_type> & rows,
+                   const std::vector<numeric_index_type> & cols);
+
+  /**
+   * Stages the addition of \p dm to the matrix rows and columns
+   * \p dofs.
+   */
+  void add_matrix (const DenseMatrix<T> & dm,
+                   const std::vector<numeric_index_type> & dofs)
+  { this->add_matrix(dm, dofs, dofs); }
+
+  /**
+   * Stages the addition of \p dv to the vector entries \p dofs.
+   */
+  void add_vector (const DenseVector<T> & dv,
+                   const std::vector<numeric_index_type> & dofs);
+
+  /**
+   * Adds all staged entries to the matrix and vector.
+   */
+  void flush ();
+
+  /**
+   * \returns The number of matrix and vector entries staged.
+   */
+  std::size_t n_staged () const
+  { return _matrix_entries.size() + _vector_entries.size(); }
+
+private:
+
+  struct MatrixEntry
+  {
+    numeric_index_type row, col;
+    T value;
+  };
+
+  struct VectorEntry
+  {
+    numeric_index_type index;
+    T value;
+  };
+
+  SparseMatrix<T> * _matrix;
+
+  NumericVector<T> * _vector;
+
+  Threads::spin_mutex * _mutex;
+
+  std::size_t _max_entries;
+
+  std::vector<MatrixEntry> _matrix_entries;
+
+  std::vector<VectorEntry> _vector_entries;
+};
+
+} // namespace libMesh
+
+#endif // LIBMESH_ASSEMBLY_BUFFER_H
@@ -25,6 +25,7 @@
 #define LIBMESH_DISTRIBUTED_VECTOR_H
 
 // Local includes
+#include "libmesh/ghost_exchange_plan.h"
 #include "libmesh/int_range.h"
 #include "libmesh/numeric_vector.h"
 #include "libmesh/parallel.h"
@@ -213,6 +214,23 @@ public:
   virtual void localize (NumericVector<T> & v_local,
                          const std::vector<numeric_index_type> & send_list) const override;
 
+  /**
+   * Updates only our own entries of \p v_local and those on \p
+   * send_list, leaving any others as they were; unlike the overload
+   * without a plan, this does not fill the whole of \p v_local.
+   */
+  virtual void localize (NumericVector<T> & v_local,
+                         const std::vector<numeric_index_type> & send_list,
+                         const GhostExchangePlan & plan) const override;
+
+  virtual void localize_begin (NumericVector<T> & v_local,
+                               const std::vector<numeric_index_type> & send_list,
+                               const GhostExchangePlan & plan) const override;
+
+  virtual void localize_end (NumericVector<T> & v_local,
+                             const std::vector<numeric_index_type> & send_list,
+                             const GhostExchangePlan & plan) const override;
+
   virtual void localize (std::vector<T> & v_local,
                          const std::vector<numeric_index_type> & indices) const override;
 
@@ -246,6 +264,12 @@ private:
    */
   std::vector<std::pair<numeric_index_type, T>> _remote_values;
 
+  /**
+   * Ghost values in flight to this vector between localize_begin()
+   * and localize_end()
+   */
+  GhostExchangePlan::PendingExchange<T> _pending_localize;
+
   /**
    * Whether we are adding or setting remote values or neither - this
    * determines behavior at the next close();
@@ -0,0 +1,253 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2025 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_GHOST_EXCHANGE_PLAN_H
+#define LIBMESH_GHOST_EXCHANGE_PLAN_H
+
+// Local includes
+#include "libmesh/libmesh_common.h"
+#include "libmesh/id_types.h"
+#include "libmesh/int_range.h"
+#include "libmesh/parallel_object.h"
+
+// TIMPI includes
+#include "timpi/parallel_implementation.h"
+#include "timpi/request.h"
+
+// C++ includes
+#include <algorithm>
+#include <vector>
+
+namespace libMesh
+{
+
+/**
+ * The communication pattern needed to fill the ghost entries of a
+ * distributed vector: which processors own each of our ghost
+ * indices, and which of our owned entries each other processor
+ * needs.
+ *
+ * Building a plan costs one round of communication; afterward each
+ * exchange() only posts one nonblocking send per neighboring
+ * processor, packed from precomputed local offsets, and one receive
+ * per neighbor, unpacked into contiguous ranges of the ghost list.
+ * An exchange can also be split between start_exchange() and
+ * finish_exchange(), to overlap it with other work.
+ * The \p DofMap builds a plan for its send_list in \p
+ * prepare_send_list(), so that the ghost update in every \p
+ * System::update() can reuse it.
+ *
+ * \date 2025
+ * \brief Reusable neighbor lists for ghost value exchange.
+ */
+class GhostExchangePlan : public ParallelObject
+{
+public:
+  /**
+   * Constructor.  \p end_indices gives the end of the index range
+   * owned by each processor, and \p ghost_indices is a sorted list
+   * of the indices whose values this processor needs.  Indices owned
+   * by this processor are allowed, and are copied locally.
+   *
+   * This is a collective operation.
+   */
+  GhostExchangePlan (const Parallel::Communicator & comm_in,
+                     const std::vector<numeric_index_type> & end_indices,
+                     const std::vector<numeric_index_type> & ghost_indices);
+
+  /**
+   * \returns The number of ghost indices the plan was built for.
+   */
+  std::size_t n_ghosts () const { return _n_ghosts; }
+
+  /**
+   * \returns The number of processors we receive values from.
+   */
+  std::size_t n_receive_neighbors () const { return _receives.size(); }
+
+  /**
+   * \returns The number of processors we send values to.
+   */
+  std::size_t n_send_neighbors () const { return _sends.size(); }
+
+  /**
+   * Fills \p ghost_values, in the order of the ghost indices the plan
+   * was built with, from the \p owned_values (indexed from the first
+   * local index) of each owning processor.
+   *
+   * This is a collective operation.
+   */
+  template <typename T>
+  void exchange (const std::vector<T> & owned_values,
+                 std::vector<T> & ghost_values) const;
+
+  /**
+   * The buffers and requests of an exchange in progress.
+   */
+  template <typename T>
+  struct PendingExchange
+  {
+    std::vector<std::vector<T>> send_buffers, receive_buffers;
+    std::vector<Parallel::Request> send_requests, receive_requests;
+    std::vector<T> local_values;
+  };
+
+  /**
+   * Posts the nonblocking sends and receives of an exchange, so that
+   * other work can be done before finish_exchange() is called with
+   * the same \p pending object.
+   *
+   * This is a collective operation.
+   */
+  template <typename T>
+  void start_exchange (const std::vector<T> & owned_values,
+                       PendingExchange<T> & pending) const;
+
+  /**
+   * Waits for the exchange begun by start_exchange() and fills \p
+   * ghost_values, as for exchange().
+   */
+  template <typename T>
+  void finish_exchange (PendingExchange<T> & pending,
+                        std::vector<T> & ghost_values) const;
+
+private:
+
+  /**
+   * The range [begin, end) of the ghost list owned by \p pid.
+   */
+  struct Receive
+  {
+    processor_id_type pid;
+    std::size_t begin, end;
+  };
+
+  /**
+   * The offsets of the owned values requested by \p pid.
+   */
+  struct Send
+  {
+    processor_id_type pid;
+    std::vector<numeric_index_type> offsets;
+  };
+
+  std::size_t _n_ghosts;
+
+  std::vector<Receive> _receives;
+
+  std::vector<Send> _sends;
+
+  /**
+   * The start within the ghost list, and the offsets of the owned
+   * values, of any ghost indices we own ourselves.
+   */
+  std::size_t _local_begin;
+
+  std::vector<numeric_index_type> _local_offsets;
+
+  /**
+   * A tag reserved for this plan's exchanges.
+   */
+  Parallel::MessageTag _tag;
+};
+
+
+
+// ------------------------------------------------------------
+// GhostExchangePlan inline methods
+template <typename T>
+inline
+void GhostExchangePlan::exchange (const std::vector<T> & owned_values,
+                                  std::vector<T> & ghost_values) const
+{
+  PendingExchange<T> pending;
+  this->start_exchange(owned_values, pending);
+  this->finish_exchange(pending, ghost_values);
+}
+
+
+
+template <typename T>
+inline
+void GhostExchangePlan::start_exchange (const std::vector<T> & owned_values,
+                                        PendingExchange<T> & pending) const
+{
+  // Post our receives first, into buffers of the sizes we expect
+  pending.receive_buffers.resize(_receives.size());
+  pending.receive_requests.resize(_receives.size());
+  for (auto i : index_range(_receives))
+    {
+      const Receive & receive = _receives[i];
+      pending.receive_buffers[i].resize(receive.end - receive.begin);
+      this->comm().receive(receive.pid, pending.receive_buffers[i],
+                           pending.receive_requests[i], _tag);
+    }
+
+  pending.send_buffers.resize(_sends.size());
+  pending.send_requests.resize(_sends.size());
+  for (auto i : index_range(_sends))
+    {
+      const Send & send = _sends[i];
+      std::vector<T> & buffer = pending.send_buffers[i];
+      buffer.clear();
+      buffer.reserve(send.offsets.size());
+      for (auto offset : send.offsets)
+        {
+          libmesh_assert_less(offset, owned_values.size());
+          buffer.push_back(owned_values[offset]);
+        }
+      this->comm().send(send.pid, buffer, pending.send_requests[i], _tag);
+    }
+
+  // Ghost indices we own ourselves just need copying
+  pending.local_values.resize(_local_offsets.size());
+  for (auto i : index_range(_local_offsets))
+    {
+      libmesh_assert_less(_local_offsets[i], owned_values.size());
+      pending.local_values[i] = owned_values[_local_offsets[i]];
+    }
+}
+
+
+
+template <typename T>
+inline
+void GhostExchangePlan::finish_exchange (PendingExchange<T> & pending,
+                                         std::vector<T> & ghost_values) const
+{
+  libmesh_assert_equal_to(pending.receive_requests.size(), _receives.size());
+  libmesh_assert_equal_to(pending.send_requests.size(), _sends.size());
+
+  ghost_values.resize(_n_ghosts);
+
+  std::copy(pending.local_values.begin(), pending.local_values.end(),
+            ghost_values.begin() + _local_begin);
+
+  Parallel::wait(pending.receive_requests);
+  for (auto i : index_range(_receives))
+    std::copy(pending.receive_buffers[i].begin(),
+              pending.receive_buffers[i].end(),
+              ghost_values.begin() + _receives[i].begin);
+
+  Parallel::wait(pending.send_requests);
+}
+
+} // namespace libMesh
+
+#endif // LIBMESH_GHOST_EXCHANGE_PLAN_H
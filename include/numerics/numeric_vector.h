@@ -44,6 +44,7 @@ namespace libMesh
 
 // forward declarations
 template <typename T> class NumericVector;
+class GhostExchangePlan;
 template <typename T> class DenseVector;
 template <typename T> class DenseSubVector;
 template <typename T> class SparseMatrix;
@@ -621,6 +622,42 @@ public:
   virtual void localize (NumericVector<T> & v_local,
                          const std::vector<numeric_index_type> & send_list) const = 0;
 
+  /**
+   * Same, but \p plan holds a precomputed communication pattern for
+   * \p send_list (e.g. from \p DofMap::get_send_list_plan()), which
+   * subclasses may reuse rather than rediscovering which processors
+   * own which entries.  By default the plan is ignored.
+   *
+   * Only the entries of \p v_local which \p this owns and those on
+   * \p send_list are sure to be updated, as with a ghosted \p
+   * v_local.  Subclasses may leave any other entries of a full-size
+   * \p v_local as they were, so callers should not read them.
+   */
+  virtual void localize (NumericVector<T> & v_local,
+                         const std::vector<numeric_index_type> & send_list,
+                         const GhostExchangePlan & /* plan */) const
+  { this->localize(v_local, send_list); }
+
+  /**
+   * Begins the same localization, for completion by localize_end()
+   * with the same arguments, so that subclasses may overlap the
+   * communication with other work.  Until then the entries of \p
+   * v_local which \p this owns are valid and may be read, but the
+   * others are not, and neither vector may be modified.  By default
+   * the whole localization is done here.
+   */
+  virtual void localize_begin (NumericVector<T> & v_local,
+                               const std::vector<numeric_index_type> & send_list,
+                               const GhostExchangePlan & plan) const
+  { this->localize(v_local, send_list, plan); }
+
+  /**
+   * Completes a localization begun by localize_begin().
+   */
+  virtual void localize_end (NumericVector<T> & /* v_local */,
+                             const std::vector<numeric_index_type> & /* send_list */,
+                             const GhostExchangePlan & /* plan */) const {}
+
   /**
    * Fill in the local std::vector "v_local" with the global indices
    * given in "indices".
@@ -312,6 +312,18 @@ public:
   virtual void localize (NumericVector<T> & v_local,
                          const std::vector<numeric_index_type> & send_list) const override;
 
+  /**
+   * Starts the ghost update of a GHOSTED \p v_local, to be completed
+   * by localize_end(); other vectors are localized immediately.
+   */
+  virtual void localize_begin (NumericVector<T> & v_local,
+                               const std::vector<numeric_index_type> & send_list,
+                               const GhostExchangePlan & plan) const override;
+
+  virtual void localize_end (NumericVector<T> & v_local,
+                             const std::vector<numeric_index_type> & send_list,
+                             const GhostExchangePlan & plan) const override;
+
   virtual void localize (std::vector<T> & v_local,
                          const std::vector<numeric_index_type> & indices) const override;
 
@@ -23,6 +23,11 @@
 #include "libmesh/libmesh_config.h"
 #include "libmesh/libmesh_common.h"  // for libmesh_assert
 
+// C++ includes
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
 
 // Compile-time check: TBB and pthreads are now mutually exclusive.
 #if defined(LIBMESH_HAVE_TBB_API) && defined(LIBMESH_HAVE_PTHREAD)
@@ -190,6 +195,20 @@ public:
     _grainsize(r._grainsize)
   {}
 
+  /**
+   * NOTE: When using pthreads this constructor is MANDATORY!!!
+   *
+   * Copy constructor.  Makes a copy of \p r restricted to [first,
+   * last).
+   */
+  BlockedRange (const BlockedRange<T> & r,
+                const const_iterator first,
+                const const_iterator last):
+    _end(last),
+    _begin(first),
+    _grainsize(r._grainsize)
+  {}
+
   /**
    * Splits the range \p r.  The first half
    * of the range is left in place, the second
@@ -267,6 +286,60 @@ private:
 
 
 
+/**
+ * Sorts [first, last) with respect to \p comp, using every available
+ * thread: blocks are sorted concurrently and then merged pairwise.
+ * Like \p std::sort, this is not a stable sort, so callers wanting
+ * a result independent of thread count should use a \p comp which
+ * orders distinct entries strictly.
+ */
+template <typename RandomIt, typename Compare>
+void parallel_sort (RandomIt first, RandomIt last, Compare comp)
+{
+  const std::size_t n = std::distance(first, last);
+
+  // Don't bother splitting up small blocks
+  const std::size_t min_block_size = 4096;
+  const std::size_t n_blocks =
+    std::min(std::size_t(libMesh::n_threads()), n / min_block_size);
+
+  if (n_blocks < 2)
+    {
+      std::sort(first, last, comp);
+      return;
+    }
+
+  std::vector<std::size_t> bounds(n_blocks+1);
+  for (std::size_t b = 0; b <= n_blocks; ++b)
+    bounds[b] = n * b / n_blocks;
+
+  parallel_for
+    (BlockedRange<std::size_t>(0, n_blocks, 1),
+     [first, &bounds, &comp](const BlockedRange<std::size_t> & range)
+     {
+       for (std::size_t b = range.begin(); b != range.end(); ++b)
+         std::sort(first + bounds[b], first + bounds[b+1], comp);
+     });
+
+  for (std::size_t width = 1; width < n_blocks; width *= 2)
+    parallel_for
+      (BlockedRange<std::size_t>(0, (n_blocks + 2*width - 1) / (2*width), 1),
+       [first, width, n_blocks, &bounds, &comp](const BlockedRange<std::size_t> & range)
+       {
+         for (std::size_t m = range.begin(); m != range.end(); ++m)
+           {
+             const std::size_t lo = 2*m*width,
+               mid = std::min(lo + width, n_blocks),
+               hi = std::min(lo + 2*width, n_blocks);
+             if (mid < hi)
+               std::inplace_merge(first + bounds[lo], first + bounds[mid],
+                                  first + bounds[hi], comp);
+           }
+       });
+}
+
+
+
 /**
  * A convenient spin mutex object which can be used for obtaining locks.
  */
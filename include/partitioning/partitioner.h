@@ -55,7 +55,7 @@ public:
   /**
    * Constructor.
    */
-  Partitioner () : _weights(nullptr) {}
+  Partitioner () : _weights(nullptr), _n_migrated_elem(0) {}
 
   /**
    * Copy/move ctor, copy/move assignment operator, and destructor are
@@ -156,6 +156,13 @@ public:
    */
   void repartition (MeshBase & mesh);
 
+  /**
+   * \returns The number of active elements, over all processors,
+   * whose processor id was changed by the last repartition() call,
+   * and which will therefore migrate when the mesh is redistributed.
+   */
+  dof_id_type n_migrated_elem () const { return _n_migrated_elem; }
+
   /**
    * These functions assign processor IDs to newly-created elements
    * (in parallel) which are currently assigned to processor 0.
@@ -212,6 +219,22 @@ public:
    */
   virtual void attach_weights(ErrorVector * /*weights*/) { libmesh_not_implemented(); }
 
+  /**
+   * \returns The ratio of the largest total weight on any one
+   * partition of \p mesh to the average total weight per partition,
+   * with element weights given by \p weights as for attach_weights().
+   * A perfectly balanced partitioning returns 1.
+   *
+   * Comparing this for the weights a partitioning was computed with
+   * (the predicted imbalance) and for weights measured afterward
+   * (the achieved imbalance) shows how well those weights model the
+   * real cost of each element.
+   *
+   * This is a collective operation.
+   */
+  static Real weight_imbalance (const MeshBase & mesh,
+                                const ErrorVector & weights);
+
 protected:
 
   /**
@@ -280,6 +303,11 @@ protected:
    */
   ErrorVector * _weights;
 
+  /**
+   * The number of active elements moved by the last repartition().
+   */
+  dof_id_type _n_migrated_elem;
+
   /**
    * Maps active element ids into a contiguous range, as needed by parallel partitioner.
    */
@@ -47,7 +47,9 @@ public:
    * curve type to "Hilbert".
    */
   SFCPartitioner () :
-    _sfc_type ("Hilbert")
+    _sfc_type ("Hilbert"),
+    _incremental_tolerance (0),
+    _keep_processor_ids (false)
   {}
 
   /**
@@ -82,6 +84,52 @@ public:
     _sfc_type = std::move(sfc_type);
   }
 
+  /**
+   * If \p tolerance is positive, repartition() keeps the current
+   * processor ids of as many elements as possible instead of
+   * computing a fresh partitioning: each cut of the curve may move
+   * from its balanced position by up to \p tolerance times the
+   * average partition weight, to wherever the fewest elements change
+   * processors.  Each partition's weight then differs from its
+   * balanced value by at most twice that, and elements only move
+   * between partitions adjacent on the curve.
+   *
+   * partition() does the same if every element already has a
+   * processor id, so setting this on a mesh's partitioner also
+   * applies it whenever MeshBase::partition() repartitions that mesh,
+   * e.g. after adaptive refinement.
+   *
+   * Like the rest of this partitioner, this requires a serialized
+   * mesh; distributed meshes are not supported.
+   *
+   * The tolerance should be less than one half.  It defaults to zero.
+   */
+  void set_incremental_repartitioning (Real tolerance)
+  {
+    libmesh_assert_greater_equal (tolerance, 0);
+    libmesh_assert_less (tolerance, 0.5);
+
+    _incremental_tolerance = tolerance;
+  }
+
+  /**
+   * Attach weights, indexed by element id, to be balanced between
+   * partitions instead of element counts: the curve is cut into
+   * pieces of nearly equal total weight.  Weights are ignored if the
+   * library was built without space filling curve support.
+   */
+  virtual void attach_weights(ErrorVector * weights) override { _weights = weights; }
+
+  /**
+   * Partitions the mesh as Partitioner::partition() does, keeping
+   * current processor ids as far as set_incremental_repartitioning()
+   * allows, if every element has one.
+   */
+  virtual void partition (MeshBase & mesh,
+                          const unsigned int n) override;
+
+  using Partitioner::partition;
+
   /**
    * Called by the SubdomainPartitioner to partition elements in the range (it, end).
    */
@@ -98,13 +146,43 @@ protected:
   virtual void _do_partition (MeshBase & mesh,
                               const unsigned int n) override;
 
+  /**
+   * Repartition the \p MeshBase into \p n subdomains, incrementally
+   * if requested via set_incremental_repartitioning().
+   */
+  virtual void _do_repartition (MeshBase & mesh,
+                                const unsigned int n) override;
+
 
 private:
 
+  /**
+   * Partitions elements in the range (it, end), shifting the curve
+   * cuts toward their current processor ids if \p incremental.
+   */
+  void sfc_partition_range (MeshBase & mesh,
+                            MeshBase::element_iterator it,
+                            MeshBase::element_iterator end,
+                            const unsigned int n,
+                            bool incremental);
+
   /**
    * The type of space-filling curve to use.  Hilbert by default.
    */
   std::string _sfc_type;
+
+  /**
+   * How far, relative to the average partition weight, repartition()
+   * may shift curve cuts to avoid migration.  Zero to repartition
+   * from scratch.
+   */
+  Real _incremental_tolerance;
+
+  /**
+   * Whether the partition() in progress should keep current
+   * processor ids.
+   */
+  bool _keep_processor_ids;
 };
 
 } // namespace libMesh
@@ -1007,6 +1007,15 @@ public:
    */
   void set_jacobian_tolerance(Real tol);
 
+  /**
+   * Calls enable_tensor_product_evaluation() on the element interior
+   * FE objects controlled by this class, so that, on tensor product
+   * elements and quadrature rules, their shape functions and the
+   * interior_values() and interior_gradients() of their variables are
+   * computed by sum factorization.
+   */
+  void enable_tensor_product_evaluation(bool enable = true);
+
   /**
    * Current side for side_* to examine
    */
@@ -1078,6 +1087,12 @@ protected:
   mutable int _real_fe_derivative_level;
   mutable int _real_grad_fe_derivative_level;
 
+  /**
+   * Scratch space for reference gradients computed by sum
+   * factorization
+   */
+  mutable std::vector<std::vector<Number>> _tensor_product_ref_grad;
+
 #ifdef LIBMESH_ENABLE_INFINITE_ELEMENTS
   mutable bool _real_fe_is_inf;
   mutable bool _real_grad_fe_is_inf;
@@ -26,13 +26,18 @@
 
 // C++ includes
 #include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
 
 namespace libMesh
 {
 
 // Forward Declarations
 class DiffContext;
+class ErrorVector;
 class FEMContext;
+template <typename T> class DenseVector;
 
 
 /**
@@ -100,6 +105,51 @@ public:
                          bool apply_heterogeneous_constraints = false,
                          bool apply_no_constraints = false) override;
 
+  /**
+   * A user-supplied element kernel for matrix-free operator
+   * application: given a reinitialized context and the (constrained)
+   * local coefficients of an input vector, adds the product of the
+   * unconstrained element Jacobian with those coefficients to the
+   * output, which arrives zeroed and correctly sized.  This must be
+   * the Jacobian of the element residual the time solver assembles,
+   * e.g. just the \p element_time_derivative() Jacobian for a \p
+   * SteadySolver.
+   */
+  typedef std::function<void (FEMContext &,
+                              const DenseVector<Number> &,
+                              DenseVector<Number> &)> ElementJacobianAction;
+
+  /**
+   * Adds the product of the system Jacobian with \p arg to \p dest,
+   * without assembling a global matrix.  The result matches
+   * multiplying by the matrix from \p assembly(false, true), with the
+   * same constraint treatment.
+   *
+   * By default each element Jacobian is computed as in \p assembly()
+   * and applied in place.  If \p action is given, it is called
+   * instead, so physics which can apply their Jacobian more cheaply
+   * than they can form it (e.g. with sum factorization) never build
+   * element matrices at all.  \p action cannot see nonlocal (SCALAR
+   * variable) terms, so it is not supported on systems with SCALAR
+   * variables.
+   *
+   * A GHOSTED \p arg, with ghost entries for the DofMap send list, is
+   * used in place; any other is first localized into a temporary.
+   *
+   * As with \p assembly(), \link update() \endlink must have been
+   * called after any change to \link solution \endlink.
+   */
+  void jacobian_vector_mult_add (NumericVector<Number> & dest,
+                                 const NumericVector<Number> & arg,
+                                 const ElementJacobianAction * action = nullptr);
+
+  /**
+   * Adds the diagonal of the system Jacobian, as \p assembly(false,
+   * true) would build it, to \p dest, without assembling a global
+   * matrix.  Useful for Jacobi preconditioning of matrix-free solves.
+   */
+  void jacobian_diagonal_add (NumericVector<Number> & dest);
+
   /**
    * Invokes the solver associated with the system.  For steady state
    * solvers, this will find a root x where F(x) = 0.  For transient
@@ -167,6 +217,20 @@ public:
                                         bool include_liftfunc = true,
                                         bool apply_constraints = true) override;
 
+  /**
+   * Reinitializes constraints, and discards any element coloring
+   * computed for the previous mesh and dof numbering.
+   */
+  virtual void reinit_constraints () override;
+
+  /**
+   * \returns \p true if overlapped_assembly (and not
+   * colored_assembly) is set, in which case assembly() updates
+   * current_local_solution itself.
+   */
+  virtual bool assembly_updates_local_solution () const override
+  { return overlapped_assembly && !colored_assembly; }
+
   /**
    * If fe_reinit_during_postprocess is true (it is true by default), FE
    * objects will be reinit()ed with their default quadrature rules.  If false,
@@ -175,6 +239,105 @@ public:
    */
   bool fe_reinit_during_postprocess;
 
+  /**
+   * If colored_assembly is true, assembly() processes elements one
+   * color at a time, as given by
+   * DofMap::color_active_local_elements().  Elements of one color
+   * share no dofs, so when the system matrix and residual are PETSc
+   * objects, which lock internally around each insertion, threads
+   * add element contributions to them without also taking the
+   * common assembly lock.  Other matrix and vector implementations
+   * (Eigen, Laspack, DistributedVector, ...) may modify shared
+   * storage even when inserting into disjoint rows, so with those
+   * the common lock is still taken.
+   *
+   * Colors are computed on first use after each reinit_constraints().
+   * This defaults to false.
+   */
+  bool colored_assembly;
+
+  /**
+   * If staged_assembly is true, each assembly() thread stages its
+   * element contributions in an AssemblyBuffer and adds them to the
+   * global matrix and residual in sorted batches, at the end of its
+   * element range, instead of locking and inserting once per
+   * element.  This trades memory for fewer global insertion calls
+   * and less lock contention.
+   *
+   * This defaults to false.
+   */
+  bool staged_assembly;
+
+  /**
+   * If overlapped_assembly is true, assembly() refreshes
+   * current_local_solution itself, starting the ghost value exchange
+   * with System::update_begin(), assembling "interior" elements while
+   * it is in flight, and assembling the remaining elements after
+   * System::update_end().  An element is interior if its dofs, and
+   * those of every element the DofMap's coupling functors couple it
+   * to, are all locally owned and unconstrained.  Interior elements
+   * read their solution values from \p solution rather than
+   * current_local_solution, so element assembly code should not read
+   * current_local_solution directly.
+   * This hides communication latency when there are many interior
+   * elements per processor.
+   *
+   * Solvers see this through assembly_updates_local_solution(), and
+   * leave the update to assembly() rather than exchanging ghost
+   * values twice.  If the DiffSolver enforces constraints exactly,
+   * assembly() also enforces them on current_local_solution after
+   * the update, as PetscDiffSolver would have.
+   *
+   * colored_assembly takes precedence over this.  The element split
+   * is computed on first use after each reinit_constraints().  This
+   * defaults to false.
+   */
+  bool overlapped_assembly;
+
+  /**
+   * If time_element_assembly is true, assembly() records the wall
+   * time spent assembling each active local element, from which
+   * element_assembly_weights() can build partitioner weights
+   * reflecting what each element really costs.
+   *
+   * An element's time runs from its reinit through constraint
+   * application.  Insertion into the global matrix and vector,
+   * including any wait for the assembly lock and, with
+   * staged_assembly, every buffer flush, is summed per thread and
+   * shared evenly among that thread's elements, so that neither lock
+   * contention nor the timing of flushes is charged to the element
+   * which happened to meet it.
+   *
+   * Times are kept by element unique id, on the processor which
+   * assembled the element, so they survive renumbering and
+   * refinement; reinit_constraints() discards only those of elements
+   * no longer in the mesh.  They are discarded entirely by
+   * clear_element_assembly_times().  Unique ids are required.  This
+   * defaults to false.
+   */
+  bool time_element_assembly;
+
+  /**
+   * Fills \p weights, indexed by element id and identical on every
+   * processor, from the element assembly times accumulated so far,
+   * for use with Partitioner::attach_weights().
+   *
+   * Weights are scaled to integers averaging 100, since some
+   * partitioners (e.g. MetisPartitioner) truncate them.  An element
+   * refined since it was last timed gets its share of the time of its
+   * nearest timed ancestor, split evenly among children at each
+   * level.  Active elements with no timed ancestor either get the
+   * average weight.
+   *
+   * This is a collective operation.
+   */
+  void element_assembly_weights (ErrorVector & weights) const;
+
+  /**
+   * Discards the element assembly times accumulated so far.
+   */
+  void clear_element_assembly_times ();
+
   /**
    * If calculating numeric jacobians is required, the FEMSystem
    * will perturb each solution vector entry by numerical_jacobian_h
@@ -255,7 +418,37 @@ protected:
   virtual void init_data () override;
 
 private:
+  /**
+   * Adds the product of the nonlocal (SCALAR variable) Jacobian with
+   * \p x to \p dest, or its diagonal if \p x is null.
+   */
+  void add_nonlocal_jacobian_action (const NumericVector<Number> * x,
+                                     NumericVector<Number> & dest);
+
   std::vector<Real> _numerical_jacobian_h_for_var;
+
+  /**
+   * Active local elements partitioned into colors, for
+   * colored_assembly.
+   */
+  std::vector<std::vector<const Elem *>> _element_colors;
+
+  /**
+   * Active local elements which need no ghosted solution values, and
+   * those which may, for overlapped_assembly.
+   */
+  std::vector<const Elem *> _interior_elements, _boundary_elements;
+
+  /**
+   * Fills _interior_elements and _boundary_elements.
+   */
+  void split_overlapped_elements ();
+
+  /**
+   * Total assembly wall time in seconds, and the number of assemblies
+   * it covers, by element unique id, for time_element_assembly.
+   */
+  std::unordered_map<unique_id_type, std::pair<double, unsigned int>> _element_assembly_times;
 };
 
 // --------------------------------------------------------------
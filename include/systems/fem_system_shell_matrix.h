@@ -0,0 +1,117 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2025 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_FEM_SYSTEM_SHELL_MATRIX_H
+#define LIBMESH_FEM_SYSTEM_SHELL_MATRIX_H
+
+// Local includes
+#include "libmesh/libmesh_common.h"
+#include "libmesh/fem_system.h"
+#include "libmesh/shell_matrix.h"
+
+// C++ includes
+#include <memory>
+
+namespace libMesh
+{
+
+/**
+ * The Jacobian of an \p FEMSystem, as a shell matrix: products with
+ * it and its diagonal are computed element by element, and no global
+ * sparse matrix is ever assembled.  This can be passed to e.g. \p
+ * LinearSolver::solve() for matrix-free Krylov solves, with \p
+ * get_diagonal() available for Jacobi preconditioning.
+ *
+ * The Jacobian is taken about the system's current local solution,
+ * so \p FEMSystem::update() must be called after any change to the
+ * solution.  Products reuse one ghosted copy of their input, which
+ * is rebuilt when the system's dof counts change; call \p clear()
+ * if the send list may have changed without them, e.g. after
+ * repartitioning.  All overridden virtual functions are documented
+ * in shell_matrix.h.
+ *
+ * \date 2025
+ * \brief Matrix-free FEMSystem Jacobian.
+ */
+class FEMSystemShellMatrix : public ShellMatrix<Number>
+{
+public:
+  /**
+   * Constructor; the Jacobian will be that of \p sys.
+   */
+  explicit
+  FEMSystemShellMatrix (FEMSystem & sys);
+
+  virtual numeric_index_type m () const override;
+
+  virtual numeric_index_type n () const override;
+
+  virtual void vector_mult (NumericVector<Number> & dest,
+                            const NumericVector<Number> & arg) const override;
+
+  virtual void vector_mult_add (NumericVector<Number> & dest,
+                                const NumericVector<Number> & arg) const override;
+
+  virtual void get_diagonal (NumericVector<Number> & dest) const override;
+
+  /**
+   * Releases the ghosted work vector; the next product rebuilds it.
+   */
+  virtual void clear () override;
+
+  /**
+   * Builds the ghosted work vector for the system's current dofs.
+   */
+  virtual void init () override;
+
+  /**
+   * Uses \p action, rather than formed element Jacobians, to compute
+   * products.  The diagonal is still computed from element Jacobians.
+   * See \p FEMSystem::jacobian_vector_mult_add(); as there, systems
+   * with SCALAR variables are not supported.
+   */
+  void attach_element_action (const FEMSystem::ElementJacobianAction & action);
+
+  /**
+   * Returns to computing products from element Jacobians.
+   */
+  void detach_element_action ();
+
+private:
+
+  FEMSystem & _sys;
+
+  FEMSystem::ElementJacobianAction _action;
+
+  /**
+   * The input of the latest product, with ghost entries for the
+   * send list.
+   */
+  mutable std::unique_ptr<NumericVector<Number>> _ghosted_arg;
+
+  /**
+   * (Re)builds \p _ghosted_arg for the system's current dofs.
+   */
+  void build_ghosted_arg () const;
+};
+
+} // namespace libMesh
+
+
+#endif // LIBMESH_FEM_SYSTEM_SHELL_MATRIX_H
@@ -154,6 +154,15 @@ public:
                          bool /* apply_no_constraints */ = false)
   { libmesh_not_implemented(); }
 
+  /**
+   * \returns \p true if \p assembly() refreshes \p
+   * current_local_solution from \p solution itself, in which case
+   * solvers should not \p update() before calling it.  By default,
+   * \p false.
+   */
+  virtual bool assembly_updates_local_solution () const
+  { return false; }
+
   /**
    * Residual parameter derivative function.
    *
@@ -300,6 +300,22 @@ public:
    */
   virtual void update ();
 
+  /**
+   * Begins the same update of the local values as \p update(), for
+   * completion by \p update_end(), so that work which needs only
+   * locally owned solution values can overlap the communication.
+   * In between, the locally owned entries of \p
+   * current_local_solution are already up to date and may be read;
+   * its ghosted entries may not, and neither \p solution nor \p
+   * current_local_solution may be modified.
+   */
+  void update_begin ();
+
+  /**
+   * Completes an update begun by \p update_begin().
+   */
+  void update_end ();
+
   /**
    * Prepares \p matrix and \p _dof_map for matrix assembly.
    * Does not actually assemble anything.  For matrix assembly,
@@ -0,0 +1,315 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2025 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_FIXED_SIZE_POOL_H
+#define LIBMESH_FIXED_SIZE_POOL_H
+
+// Local includes
+#include "libmesh/threads.h"
+
+// C++ includes
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace libMesh
+{
+
+/**
+ * A thread-safe pool of equally-sized memory chunks, carved out of
+ * large contiguous slabs.  Unlike the \p PoolAllocator wrappers this
+ * does not depend on Boost.
+ *
+ * Every chunk starts with a small header recording the pool and slab
+ * it came from, so \p deallocate() can return a chunk to its pool
+ * without searching for it, and every slab keeps count of its chunks
+ * in use.  Memory obtained from \p allocate_unpooled() carries the
+ * same header with no pool, so \p deallocate() accepts both.
+ *
+ * Freed chunks are kept on an intrusive free list and handed out
+ * again by later allocations, so repeatedly building and deleting
+ * objects of one size costs no calls to the system allocator, and
+ * objects allocated in sequence end up adjacent in memory.  Slabs
+ * with no chunks left in use are returned to the system in bulk by
+ * \p release_memory().
+ *
+ * \date 2025
+ * \brief Slab-based allocator for many small objects of one size.
+ */
+class FixedSizePool
+{
+public:
+  /**
+   * Constructor.  Each chunk will hold at least \p chunk_size bytes
+   * and will be aligned for any fundamental type; each slab holds \p
+   * chunks_per_slab chunks.
+   */
+  explicit
+  FixedSizePool (std::size_t chunk_size,
+                 std::size_t chunks_per_slab = 1024);
+
+  /**
+   * Pools own their slabs, and cannot be copied or moved.
+   */
+  FixedSizePool (const FixedSizePool &) = delete;
+  FixedSizePool & operator= (const FixedSizePool &) = delete;
+
+  /**
+   * Destructor.  Frees every slab, whether or not chunks within it
+   * are still in use.
+   */
+  ~FixedSizePool ();
+
+  /**
+   * \returns A pointer to an uninitialized chunk of \p chunk_size()
+   * bytes, allocating a new slab if no freed chunks are available.
+   */
+  void * allocate ();
+
+  /**
+   * \returns A pointer to \p size uninitialized bytes from the global
+   * \p operator \p new, with a header that \p deallocate() will
+   * recognize as belonging to no pool.
+   */
+  static void * allocate_unpooled (std::size_t size);
+
+  /**
+   * Returns memory from \p allocate() on any pool, or from \p
+   * allocate_unpooled(), to where it came from.  This reads the
+   * header in front of \p p and takes only the lock of the owning
+   * pool, if any.
+   */
+  static void deallocate (void * p);
+
+  /**
+   * Frees every slab with no chunks in use, removing their chunks
+   * from the free list in a single pass.
+   *
+   * \returns \p true if any memory was freed.
+   */
+  bool release_memory ();
+
+  /**
+   * \returns The (aligned) size of each chunk, in bytes, not counting
+   * its header.
+   */
+  std::size_t chunk_size () const { return _chunk_size; }
+
+  /**
+   * \returns The number of chunks currently allocated.
+   */
+  std::size_t n_chunks_in_use () const;
+
+  /**
+   * \returns The number of slabs currently held by the pool.
+   */
+  std::size_t n_slabs () const;
+
+private:
+
+  /**
+   * The header in front of every chunk.  \p pool is null for memory
+   * from \p allocate_unpooled().
+   */
+  struct ChunkHeader
+  {
+    FixedSizePool * pool;
+    std::size_t slab;
+  };
+
+  /**
+   * Space reserved for the header, keeping chunks aligned for any
+   * fundamental type.
+   */
+  static constexpr std::size_t header_size =
+    ((sizeof(ChunkHeader) + alignof(std::max_align_t) - 1) /
+     alignof(std::max_align_t)) * alignof(std::max_align_t);
+
+  static ChunkHeader & header (void * p)
+  { return *reinterpret_cast<ChunkHeader *>(static_cast<char *>(p) - header_size); }
+
+  /**
+   * Returns the chunk at \p p to this pool.
+   */
+  void deallocate_chunk (void * p);
+
+  /**
+   * Allocates a new slab and threads its chunks onto the free list.
+   * The caller must hold \p _mutex.
+   */
+  void add_slab ();
+
+  /**
+   * A slab, which is null once freed, and the number of its chunks
+   * currently in use.
+   */
+  struct Slab
+  {
+    char * begin;
+    std::size_t n_in_use;
+  };
+
+  /**
+   * Size of each chunk, rounded up for alignment, not counting its
+   * header.
+   */
+  const std::size_t _chunk_size;
+
+  /**
+   * Number of chunks carved out of each slab.
+   */
+  const std::size_t _chunks_per_slab;
+
+  /**
+   * Head of the free list.  Each free chunk stores a pointer to the
+   * next free chunk in its first bytes after the header.
+   */
+  void * _free_list;
+
+  /**
+   * Our slabs, indexed by the slab number in each chunk header, and
+   * the indices of freed slabs available for reuse.
+   */
+  std::vector<Slab> _slabs;
+  std::vector<std::size_t> _unused_slabs;
+
+  /**
+   * Number of chunks handed out and not yet returned.
+   */
+  std::size_t _n_in_use;
+
+  /**
+   * Serializes access to the free list and slabs.
+   */
+  mutable Threads::spin_mutex _mutex;
+};
+
+
+
+/**
+ * A set of \p FixedSizePool objects, one for each object size in use,
+ * from which a \p MeshBase allocates its \p Node and \p Elem objects
+ * when pooled allocation is enabled for it.  Since every \p Elem
+ * subclass has its own size, each \p ElemType effectively gets its
+ * own slabs.
+ *
+ * \p PooledObject allocations come from the arena made current on
+ * their thread by an \p ObjectArena::Scope, or from the heap if there
+ * is none.  Objects may be deleted from any thread, but must not
+ * outlive their arena.
+ *
+ * \date 2025
+ * \brief Per-mesh slab pools for Node and Elem objects.
+ */
+class ObjectArena
+{
+public:
+  ObjectArena ();
+
+  /**
+   * Arenas own their pools, and cannot be copied or moved.
+   */
+  ObjectArena (const ObjectArena &) = delete;
+  ObjectArena & operator= (const ObjectArena &) = delete;
+
+  /**
+   * Destructor.  Frees every pool.  No objects from this arena may
+   * still be alive.
+   */
+  ~ObjectArena ();
+
+  /**
+   * \returns A pointer to \p size uninitialized bytes, from the pool
+   * for that size, or unpooled if \p size is too large to be pooled.
+   * Either way the memory should be freed with \p
+   * FixedSizePool::deallocate().
+   */
+  void * allocate (std::size_t size);
+
+  /**
+   * Returns every slab with no objects left alive to the system.
+   * This makes deleting many objects at once, e.g. remote elements
+   * or a whole mesh, a bulk operation.
+   */
+  void release_memory ();
+
+  /**
+   * \returns The number of objects currently allocated from this
+   * arena.
+   */
+  std::size_t n_objects () const;
+
+  /**
+   * \returns The number of slabs currently held by this arena.
+   */
+  std::size_t n_slabs () const;
+
+  /**
+   * \returns The arena current on this thread, or \p nullptr.
+   */
+  static ObjectArena * current () { return _current; }
+
+  /**
+   * Makes an arena (or, given \p nullptr, the heap) current on this
+   * thread for the lifetime of the \p Scope, then restores whatever
+   * was current before.
+   */
+  class Scope
+  {
+  public:
+    explicit Scope (ObjectArena * arena) :
+      _old(ObjectArena::_current)
+    { ObjectArena::_current = arena; }
+
+    ~Scope () { ObjectArena::_current = _old; }
+
+    Scope (const Scope &) = delete;
+    Scope & operator= (const Scope &) = delete;
+
+  private:
+    ObjectArena * _old;
+  };
+
+private:
+
+  /**
+   * Objects larger than this many units of the maximum fundamental
+   * alignment are never pooled.
+   */
+  static constexpr std::size_t max_size_index = 128;
+
+  /**
+   * The pools for every object size in use, indexed by size in units
+   * of the maximum fundamental alignment, rounded up.
+   *
+   * Pools are only destroyed with the arena, so the lookup table can
+   * be read without locking; \p _mutex only serializes creation.
+   */
+  std::array<std::atomic<FixedSizePool *>, max_size_index> _by_size;
+  std::vector<std::unique_ptr<FixedSizePool>> _pools;
+  mutable Threads::spin_mutex _mutex;
+
+  static thread_local ObjectArena * _current;
+};
+
+} // namespace libMesh
+
+#endif // LIBMESH_FIXED_SIZE_POOL_H
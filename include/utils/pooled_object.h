@@ -0,0 +1,81 @@
+// The libMesh Finite Element Library.
+// Copyright (C) 2002-2025 Benjamin S. Kirk, John W. Peterson, Roy H. Stogner
+
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+
+// You should have received a copy of the GNU Lesser General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+
+
+
+#ifndef LIBMESH_POOLED_OBJECT_H
+#define LIBMESH_POOLED_OBJECT_H
+
+// Local includes
+#include "libmesh/fixed_size_pool.h"
+
+// C++ includes
+#include <cstddef>
+
+namespace libMesh
+{
+
+/**
+ * Classes which derive from \p PooledObject<Base> get class-specific
+ * \p operator \p new and \p operator \p delete which allocate from
+ * the \p ObjectArena current on the calling thread, if any.  A \p
+ * MeshBase with pooled allocation enabled owns such an arena and
+ * makes it current while it builds its own nodes and elements.
+ *
+ * Every object carries a small header saying which pool, if any, it
+ * came from, so deletion needs neither a global lookup nor a global
+ * lock, and objects built without an arena can be mixed freely with
+ * pooled ones.
+ *
+ * \date 2025
+ * \brief Mixin for arena allocation of many small objects.
+ */
+template <typename Base>
+class PooledObject
+{
+public:
+
+  /**
+   * Allocates \p size bytes from the current \p ObjectArena, or from
+   * the global \p operator \p new if there is none.
+   */
+  static void * operator new (std::size_t size)
+  {
+    if (ObjectArena * arena = ObjectArena::current())
+      return arena->allocate(size);
+    return FixedSizePool::allocate_unpooled(size);
+  }
+
+  /**
+   * Returns memory to the pool it came from, taking only that pool's
+   * lock, or to the global \p operator \p delete.
+   */
+  static void operator delete (void * p)
+  {
+    FixedSizePool::deallocate(p);
+  }
+
+protected:
+
+  PooledObject () = default;
+
+  ~PooledObject () = default;
+};
+
+} // namespace libMesh
+
+#endif // LIBMESH_POOLED_OBJECT_H
@@ -17,6 +17,7 @@
   CPPUNIT_TEST( testSetNSystemsExtraInts );     \
   CPPUNIT_TEST( testSetNVariableGroupsExtraInts ); \
   CPPUNIT_TEST( testManualDofCalculation );     \
+  CPPUNIT_TEST( testMoveIndexing );             \
   CPPUNIT_TEST( testJensEftangBug );
 
 using namespace libMesh;
@@ -394,6 +395,48 @@ public:
     CPPUNIT_ASSERT_EQUAL(static_cast<dof_id_type>(aobject.vg_dof_base(1, 1) + 0*3 + 0), aobject.dof_number(1, 2, 0));
   }
 
+  void testMoveIndexing()
+  {
+    LOG_UNIT_TEST;
+
+    DofObject & aobject(*instance);
+
+    aobject.set_n_systems (1);
+
+    std::vector<unsigned int> nvpg {2, 3};
+    aobject.set_n_vars_per_group (0, nvpg);
+    aobject.set_n_comp_group (0, 0, 1);
+    aobject.set_n_comp_group (0, 1, 3);
+    aobject.set_vg_dof_base(0, 0, 10);
+    aobject.set_vg_dof_base(0, 1, 120);
+
+    // Leave room on either side to catch overruns
+    std::vector<dof_id_type> pool(aobject.indexing_size() + 2, 42);
+    dof_id_type * end = aobject.move_indexing_to(pool.data() + 1);
+    CPPUNIT_ASSERT(end == pool.data() + pool.size() - 1);
+    CPPUNIT_ASSERT(aobject.indexing_stored_in(pool.data(), end));
+    CPPUNIT_ASSERT_EQUAL(static_cast<dof_id_type>(42), pool.front());
+    CPPUNIT_ASSERT_EQUAL(static_cast<dof_id_type>(42), pool.back());
+
+    CPPUNIT_ASSERT_EQUAL(static_cast<dof_id_type>(11), aobject.dof_number(0, 1, 0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<dof_id_type>(128), aobject.dof_number(0, 4, 2));
+
+    // Renumbering in place should write into the pool
+    aobject.set_vg_dof_base(0, 0, 20);
+    CPPUNIT_ASSERT(aobject.indexing_stored_in(pool.data(), end));
+    CPPUNIT_ASSERT_EQUAL(static_cast<dof_id_type>(21), aobject.dof_number(0, 1, 0));
+
+    // Resizing should move us back to our own storage and leave the
+    // pool alone
+    const std::vector<dof_id_type> old_pool = pool;
+    aobject.add_system();
+    CPPUNIT_ASSERT(!aobject.indexing_stored_in(pool.data(), end));
+    CPPUNIT_ASSERT(pool == old_pool);
+    CPPUNIT_ASSERT_EQUAL(2u, aobject.n_systems());
+    CPPUNIT_ASSERT_EQUAL(static_cast<dof_id_type>(21), aobject.dof_number(0, 1, 0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<dof_id_type>(128), aobject.dof_number(0, 4, 2));
+  }
+
   void testJensEftangBug()
   {
     LOG_UNIT_TEST;
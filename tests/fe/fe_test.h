@@ -4,12 +4,14 @@
 #include "test_comm.h"
 
 #include <libmesh/cell_c0polyhedron.h>
+#include <libmesh/dense_vector.h>
 #include <libmesh/dof_map.h>
 #include <libmesh/elem.h>
 #include <libmesh/equation_systems.h>
 #include <libmesh/face_c0polygon.h>
 #include <libmesh/fe.h>
 #include <libmesh/fe_base.h>
+#include <libmesh/fe_batch.h>
 #include <libmesh/fe_interface.h>
 #include <libmesh/function_base.h>
 #include <libmesh/mesh.h>
@@ -18,7 +20,11 @@
 #include <libmesh/numeric_vector.h>
 #include <libmesh/system.h>
 #include <libmesh/quadrature_gauss.h>
+#include <libmesh/reference_shape_cache.h>
+#include <libmesh/tensor_product_evaluator.h>
 
+#include <algorithm>
+#include <numeric>
 #include <vector>
 
 #include "libmesh_cppunit.h"
@@ -32,7 +38,11 @@
   CPPUNIT_TEST( testHessU );                    \
   CPPUNIT_TEST( testHessUComp );                \
   CPPUNIT_TEST( testDualDoesntScreamAndDie );   \
-  CPPUNIT_TEST( testCustomReinit );
+  CPPUNIT_TEST( testCustomReinit );             \
+  CPPUNIT_TEST( testReferenceShapeCache );      \
+  CPPUNIT_TEST( testTensorProductEvaluator );   \
+  CPPUNIT_TEST( testTensorProductOrientations ); \
+  CPPUNIT_TEST( testFEBatch );
 
 using namespace libMesh;
 
@@ -1010,6 +1020,306 @@ public:
     }
   }
 
+  void testReferenceShapeCache()
+  {
+    LOG_UNIT_TEST;
+
+    // Handle the "more processors than elements" case
+    if (!this->_elem)
+      return;
+
+    FEType fe_type = this->_sys->variable_type(0);
+    std::unique_ptr<FEBase> fe1 (FEBase::build(this->_dim, fe_type));
+    std::unique_ptr<FEBase> fe2 (FEBase::build(this->_dim, fe_type));
+    fe1->attach_quadrature_rule (this->_qrule.get());
+    fe2->attach_quadrature_rule (this->_qrule.get());
+
+    const std::vector<std::vector<Real>> & phi2 = fe2->get_phi();
+    const std::vector<std::vector<Real>> & dphidxi1 = fe1->get_dphidxi();
+    const std::vector<std::vector<Real>> & dphidxi2 = fe2->get_dphidxi();
+    fe1->get_phi();
+    fe1->get_dphi();
+    fe2->get_dphi();
+
+    const ReferenceShapeCache<Real> & cache =
+      ReferenceShapeCache<Real>::thread_cache();
+
+    fe1->reinit(this->_elem);
+    const std::size_t hits_before = cache.n_hits();
+    fe2->reinit(this->_elem);
+
+    // The second FE object should reuse the first one's reference
+    // shapes, if this family allows it
+    const bool cacheable =
+      (family == LAGRANGE || family == MONOMIAL) &&
+      this->_elem->mapping_type() == LAGRANGE_MAP &&
+      !this->_elem->runtime_topology();
+
+    if (cacheable)
+      CPPUNIT_ASSERT_EQUAL(hits_before + 1, cache.n_hits());
+
+    CPPUNIT_ASSERT_EQUAL(dphidxi1.size(), dphidxi2.size());
+    for (auto i : index_range(dphidxi1))
+      {
+        CPPUNIT_ASSERT_EQUAL(dphidxi1[i].size(), dphidxi2[i].size());
+        for (auto qp : index_range(dphidxi1[i]))
+          CPPUNIT_ASSERT_EQUAL(dphidxi1[i][qp], dphidxi2[i][qp]);
+      }
+
+    if (!cacheable)
+      return;
+
+    // Cached values should be the shape functions, and should stay so
+    // when a reinit on the same type doesn't refill them
+    const std::vector<Point> & qpoints = this->_qrule->get_points();
+    for (unsigned int pass = 0; pass != 2; ++pass)
+      {
+        CPPUNIT_ASSERT_EQUAL(std::size_t(FEInterface::n_dofs(fe_type, this->_elem)), phi2.size());
+        for (auto i : index_range(phi2))
+          for (auto qp : index_range(qpoints))
+            LIBMESH_ASSERT_FP_EQUAL(FEInterface::shape(fe_type, this->_elem, i, qpoints[qp]),
+                                    phi2[i][qp], this->_value_tol);
+
+        fe2->reinit(this->_elem);
+      }
+  }
+
+  void testTensorProductEvaluator()
+  {
+    LOG_UNIT_TEST;
+
+    // Handle the "more processors than elements" case
+    if (!this->_elem)
+      return;
+
+    FEType fe_type = this->_sys->variable_type(0);
+
+    const std::vector<std::vector<Real>> & phi = this->_fe->get_phi();
+    const std::vector<std::vector<Real>> * ref_dphi[3] =
+      { &this->_fe->get_dphidxi(),
+#if LIBMESH_DIM > 1
+        &this->_fe->get_dphideta(),
+#else
+        nullptr,
+#endif
+#if LIBMESH_DIM > 2
+        &this->_fe->get_dphidzeta() };
+#else
+        nullptr };
+#endif
+
+    this->_fe->reinit(this->_elem);
+
+    if (!TensorProductEvaluator::supports(fe_type, this->_elem->type(),
+                                          *this->_qrule))
+      return;
+
+    TensorProductEvaluator tpe(fe_type, this->_elem->type(), *this->_qrule);
+    tpe.reinit(*this->_elem);
+
+    const unsigned int n_dofs = cast_int<unsigned int>(this->_dof_indices.size());
+    const unsigned int n_qp = this->_qrule->n_points();
+    CPPUNIT_ASSERT_EQUAL(n_dofs, tpe.n_dofs());
+    CPPUNIT_ASSERT_EQUAL(n_qp, tpe.n_points());
+
+    DenseVector<Number> coefs(n_dofs);
+    for (auto i : make_range(n_dofs))
+      coefs(i) = (*this->_sys->current_local_solution)(this->_dof_indices[i]);
+
+    // Sum-factorized values and reference gradients should match the
+    // brute force sums
+    std::vector<Number> values;
+    std::vector<std::vector<Number>> ref_grad;
+    tpe.interpolate(coefs, values);
+    tpe.interpolate_gradient(coefs, ref_grad);
+
+    for (auto qp : make_range(n_qp))
+      {
+        Number u = 0;
+        for (auto i : make_range(n_dofs))
+          u += phi[i][qp] * coefs(i);
+        LIBMESH_ASSERT_NUMBERS_EQUAL(u, values[qp], this->_value_tol);
+
+        for (auto d : make_range(this->_dim))
+          {
+            Number du = 0;
+            for (auto i : make_range(n_dofs))
+              du += (*ref_dphi[d])[i][qp] * coefs(i);
+            LIBMESH_ASSERT_NUMBERS_EQUAL(du, ref_grad[d][qp], this->_grad_tol);
+          }
+      }
+
+    // The transposed operations should test against every shape
+    // function
+    DenseVector<Number> residual(n_dofs), grad_residual(n_dofs);
+    tpe.integrate(values, residual);
+    tpe.integrate_gradient(ref_grad, grad_residual);
+
+    for (auto i : make_range(n_dofs))
+      {
+        Number r = 0, gr = 0;
+        for (auto qp : make_range(n_qp))
+          {
+            r += phi[i][qp] * values[qp];
+            for (auto d : make_range(this->_dim))
+              gr += (*ref_dphi[d])[i][qp] * ref_grad[d][qp];
+          }
+        LIBMESH_ASSERT_NUMBERS_EQUAL(r, residual(i), this->_value_tol);
+        LIBMESH_ASSERT_NUMBERS_EQUAL(gr, grad_residual(i), this->_grad_tol);
+      }
+
+    // Shape functions built from the 1D tables should match FE::shape
+    // on this element, whatever its edge and face orientations
+    const std::vector<Point> & qpoints = this->_qrule->get_points();
+    std::vector<std::vector<Real>> tp_phi;
+    tpe.shapes(tp_phi);
+    CPPUNIT_ASSERT_EQUAL(std::size_t(n_dofs), tp_phi.size());
+    for (auto i : make_range(n_dofs))
+      for (auto qp : make_range(n_qp))
+        LIBMESH_ASSERT_FP_EQUAL(FEInterface::shape(fe_type, this->_elem, i, qpoints[qp]),
+                                tp_phi[i][qp], this->_value_tol);
+
+    // An FE object using sum factorization should agree with one that
+    // doesn't
+    std::unique_ptr<FEBase> tp_fe = FEBase::build(this->_dim, fe_type);
+    tp_fe->attach_quadrature_rule(this->_qrule.get());
+    tp_fe->enable_tensor_product_evaluation();
+    const std::vector<std::vector<Real>> & tp_fe_phi = tp_fe->get_phi();
+    const std::vector<std::vector<RealGradient>> & tp_fe_dphi = tp_fe->get_dphi();
+    tp_fe->reinit(this->_elem);
+    CPPUNIT_ASSERT(tp_fe->get_tensor_product_evaluator());
+
+    const std::vector<std::vector<RealGradient>> & dphi = this->_fe->get_dphi();
+    for (auto i : make_range(n_dofs))
+      for (auto qp : make_range(n_qp))
+        {
+          LIBMESH_ASSERT_FP_EQUAL(phi[i][qp], tp_fe_phi[i][qp], this->_value_tol);
+          LIBMESH_ASSERT_FP_EQUAL(0, (dphi[i][qp] - tp_fe_dphi[i][qp]).norm(), this->_grad_tol);
+        }
+  }
+
+  void testTensorProductOrientations()
+  {
+    LOG_UNIT_TEST;
+
+    // Handle the "more processors than elements" case
+    if (!this->_elem)
+      return;
+
+    FEType fe_type = this->_sys->variable_type(0);
+    const ElemType type = this->_elem->type();
+
+    if (!TensorProductEvaluator::supports(fe_type, type, *this->_qrule))
+      return;
+
+    // Edge and face orientations only depend on the ordering of the
+    // vertex points, so vertices spread along a line can take on
+    // every orientation, flipped edges and rotated faces included.
+    std::unique_ptr<Elem> elem = Elem::build(type);
+    std::vector<std::unique_ptr<Node>> nodes;
+    for (auto n : make_range(elem->n_nodes()))
+      {
+        nodes.push_back(Node::build(Point(), n));
+        elem->set_node(n, nodes.back().get());
+      }
+
+    const unsigned int n_vertices = elem->n_vertices();
+    std::vector<unsigned int> ranks(n_vertices);
+    std::iota(ranks.begin(), ranks.end(), 0);
+
+    // Every ordering of edge and quad vertices; a spread of orderings
+    // of hex vertices
+    const unsigned int stride = (n_vertices > 4) ? 1679 : 1;
+
+    TensorProductEvaluator tpe(fe_type, type, *this->_qrule);
+    const std::vector<Point> & qpoints = this->_qrule->get_points();
+    std::vector<std::vector<Real>> tp_phi, tp_dphi;
+
+    unsigned int ordering = 0;
+    do
+      {
+        if (ordering++ % stride)
+          continue;
+
+        for (auto v : make_range(n_vertices))
+          elem->point(v) = Point(ranks[v]);
+
+        tpe.reinit(*elem);
+        tpe.shapes(tp_phi);
+        CPPUNIT_ASSERT_EQUAL(std::size_t(tpe.n_dofs()), tp_phi.size());
+
+        for (auto i : make_range(tpe.n_dofs()))
+          for (auto qp : index_range(qpoints))
+            LIBMESH_ASSERT_FP_EQUAL(FEInterface::shape(fe_type, elem.get(), i, qpoints[qp]),
+                                    tp_phi[i][qp], this->_value_tol);
+
+        for (auto d : make_range(this->_dim))
+          {
+            tpe.shape_derivs(d, tp_dphi);
+            for (auto i : make_range(tpe.n_dofs()))
+              for (auto qp : index_range(qpoints))
+                LIBMESH_ASSERT_FP_EQUAL(FEInterface::shape_deriv(fe_type, elem.get(), i, d, qpoints[qp]),
+                                        tp_dphi[i][qp], this->_grad_tol);
+          }
+      }
+    while (std::next_permutation(ranks.begin(), ranks.end()));
+  }
+
+  void testFEBatch()
+  {
+    LOG_UNIT_TEST;
+
+    // Batch up to a full set of lanes of our local elements
+    std::vector<const Elem *> elems;
+    for (const Elem * elem : this->_mesh->active_local_element_ptr_range())
+      if (elems.size() < FEBatch::n_lanes)
+        elems.push_back(elem);
+
+    // Handle the "more processors than elements" case
+    if (elems.empty())
+      return;
+
+    FEType fe_type = this->_sys->variable_type(0);
+    const ElemType elem_type = elems[0]->type();
+    if (!FEBatch::supports(fe_type, elem_type))
+      return;
+
+    std::unique_ptr<FEBase> fe = FEBase::build(this->_dim, fe_type);
+    fe->attach_quadrature_rule(this->_qrule.get());
+    const std::vector<Real> & JxW = fe->get_JxW();
+    const std::vector<std::vector<Real>> & phi = fe->get_phi();
+    const std::vector<std::vector<RealGradient>> & dphi = fe->get_dphi();
+    const std::vector<Point> & xyz = fe->get_xyz();
+
+    // Initialize the quadrature rule for our element type
+    fe->reinit(elems[0]);
+
+    FEBatch batch(fe_type, elem_type, *this->_qrule);
+    batch.reinit(elems);
+
+    CPPUNIT_ASSERT_EQUAL(cast_int<unsigned int>(elems.size()), batch.n_elems());
+    CPPUNIT_ASSERT_EQUAL(this->_qrule->n_points(), batch.n_points());
+
+    for (auto l : index_range(elems))
+      {
+        fe->reinit(elems[l]);
+
+        CPPUNIT_ASSERT_EQUAL(cast_int<unsigned int>(phi.size()), batch.n_dofs());
+
+        for (auto qp : index_range(JxW))
+          {
+            LIBMESH_ASSERT_FP_EQUAL(JxW[qp], batch.JxW(qp, l), this->_value_tol);
+            LIBMESH_ASSERT_FP_EQUAL(0, (xyz[qp] - batch.xyz(qp, l)).norm(), this->_value_tol);
+
+            for (auto i : index_range(phi))
+              {
+                LIBMESH_ASSERT_FP_EQUAL(phi[i][qp], batch.get_phi()[i][qp], this->_value_tol);
+                LIBMESH_ASSERT_FP_EQUAL(0, (dphi[i][qp] - batch.dphi(i, qp, l)).norm(), this->_grad_tol);
+              }
+          }
+      }
+  }
+
 };
 
 
@@ -7,6 +7,7 @@
 // libMesh includes
 #include <libmesh/parallel.h>
 #include <libmesh/fuzzy_equals.h>
+#include <libmesh/ghost_exchange_plan.h>
 
 #include "libmesh_cppunit.h"
 
@@ -17,6 +18,7 @@
   CPPUNIT_TEST( testLocalizeBase );             \
   CPPUNIT_TEST( testLocalizeIndices );          \
   CPPUNIT_TEST( testLocalizeIndicesBase );      \
+  CPPUNIT_TEST( testLocalizeSendListPlan );     \
   CPPUNIT_TEST( testLocalizeToOne );            \
   CPPUNIT_TEST( testLocalizeToOneBase );        \
   CPPUNIT_TEST( testNorms );                    \
@@ -336,6 +338,63 @@ public:
     }
   }
 
+  template <class Base, class Derived>
+  void LocalizeSendListPlan()
+  {
+    auto v_ptr = std::make_unique<Derived>(*my_comm, global_size, local_size);
+    Base & v = *v_ptr;
+
+    const libMesh::dof_id_type
+      first = v.first_local_index(),
+      last  = v.last_local_index();
+
+    for (libMesh::dof_id_type n=first; n != last; n++)
+      v.set (n, static_cast<libMesh::Number>(n));
+    v.close();
+
+    // Ask for the first and last entries of every other processor's
+    // range, and one of our own
+    std::vector<libMesh::numeric_index_type> end_indices, send_list;
+    libMesh::numeric_index_type end_index = 0;
+    for (libMesh::processor_id_type p=0; p<my_comm->size(); p++)
+      {
+        const libMesh::numeric_index_type begin_index = end_index;
+        end_index += block_size + p;
+        end_indices.push_back(end_index);
+        if (p != my_comm->rank())
+          {
+            send_list.push_back(begin_index);
+            send_list.push_back(end_index-1);
+          }
+        else
+          send_list.push_back(begin_index+1);
+      }
+
+    libMesh::GhostExchangePlan plan(*my_comm, end_indices, send_list);
+    CPPUNIT_ASSERT_EQUAL(send_list.size(), plan.n_ghosts());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(my_comm->size()-1), plan.n_receive_neighbors());
+    CPPUNIT_ASSERT_EQUAL(std::size_t(my_comm->size()-1), plan.n_send_neighbors());
+
+    auto l_ptr = std::make_unique<Derived>(*my_comm, global_size);
+    Base & l = *l_ptr;
+
+    // Do it twice, to make sure the plan is reusable
+    for (unsigned int i = 0; i != 2; ++i)
+      {
+        v.localize(l, send_list, plan);
+
+        for (libMesh::dof_id_type n=first; n != last; n++)
+          LIBMESH_ASSERT_NUMBERS_EQUAL
+            (libMesh::Real(n), l(n), libMesh::TOLERANCE*libMesh::TOLERANCE);
+
+        for (auto n : send_list)
+          LIBMESH_ASSERT_NUMBERS_EQUAL
+            (libMesh::Real(n), l(n), libMesh::TOLERANCE*libMesh::TOLERANCE);
+
+        l.zero();
+      }
+  }
+
   void testLocalize()
   {
     LOG_UNIT_TEST;
@@ -378,6 +437,13 @@ public:
     LocalizeIndices<libMesh::NumericVector<libMesh::Number>,DerivedClass>();
   }
 
+  void testLocalizeSendListPlan()
+  {
+    LOG_UNIT_TEST;
+
+    LocalizeSendListPlan<libMesh::NumericVector<libMesh::Number>,DerivedClass>();
+  }
+
   void testNorms()
   {
     LOG_UNIT_TEST;